@@ -0,0 +1,267 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+/*
+ * Track ranking benchmark
+ *
+ * Simulates a large meeting where every track publishes an audio level property. Each subscribe namespace is
+ * a PublishNamespaceHandler that selects the top-n tracks. Ticks are simulated so that the simulated duration
+ * runs as fast as the ranking allows. The latency of each ranking update, or each batch when batching is
+ * enabled, is measured with the steady clock and reported as percentiles along with the top-n switch counts.
+ */
+
+#include "publish_namespace_handler.h"
+#include "ranking_sim.h"
+#include "track_ranking.h"
+
+#include <cxxopts.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std::string_literals;
+using laps::sim::SimPublishTrackHandler;
+using laps::sim::SimTickService;
+
+namespace {
+    /**
+     * @brief Synthetic audio level of a track
+     * @details Tracks alternate between talking and silent periods. Talking tracks have a high level with
+     *      jitter so that active speakers with close levels swap rank, similar to a real meeting.
+     */
+    struct AudioLevel
+    {
+        bool talking{ false };
+
+        uint64_t Sample(std::mt19937_64& rng, double talk_start, double talk_stop)
+        {
+            std::uniform_real_distribution<double> chance(0.0, 1.0);
+            if (chance(rng) < (talking ? talk_stop : talk_start)) {
+                talking = !talking;
+            }
+
+            std::uniform_int_distribution<uint64_t> level(talking ? 60 : 0, talking ? 100 : 20);
+            return level(rng);
+        }
+    };
+
+    struct LatencySummary
+    {
+        std::size_t count{ 0 };
+        double mean_us{ 0 };
+        double p50_us{ 0 };
+        double p90_us{ 0 };
+        double p99_us{ 0 };
+        double p999_us{ 0 };
+        double max_us{ 0 };
+    };
+
+    LatencySummary Summarize(std::vector<uint64_t>& latencies_ns)
+    {
+        LatencySummary summary;
+        if (latencies_ns.empty()) {
+            return summary;
+        }
+
+        std::sort(latencies_ns.begin(), latencies_ns.end());
+
+        const auto percentile = [&](double p) {
+            const auto index = static_cast<std::size_t>(p * static_cast<double>(latencies_ns.size() - 1));
+            return static_cast<double>(latencies_ns[index]) / 1000.0;
+        };
+
+        uint64_t total_ns = 0;
+        for (const auto latency : latencies_ns) {
+            total_ns += latency;
+        }
+
+        summary.count = latencies_ns.size();
+        summary.mean_us = static_cast<double>(total_ns) / static_cast<double>(latencies_ns.size()) / 1000.0;
+        summary.p50_us = percentile(0.5);
+        summary.p90_us = percentile(0.9);
+        summary.p99_us = percentile(0.99);
+        summary.p999_us = percentile(0.999);
+        summary.max_us = static_cast<double>(latencies_ns.back()) / 1000.0;
+
+        return summary;
+    }
+
+    void PrintSummary(const std::string& name, const LatencySummary& summary)
+    {
+        std::cout << name << ": count: " << summary.count << " mean: " << summary.mean_us
+                  << " us p50: " << summary.p50_us << " us p90: " << summary.p90_us << " us p99: " << summary.p99_us
+                  << " us p99.9: " << summary.p999_us << " us max: " << summary.max_us << " us" << std::endl;
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    // clang-format off
+    cxxopts::Options options("laps_bench_ranking", "Track ranking benchmark");
+    options.set_width(75).set_tab_expansion().add_options()
+        ("h,help", "Print help")
+        ("tracks", "Number of published tracks", cxxopts::value<uint64_t>()->default_value("1000"))
+        ("rate", "Audio level updates per second per track", cxxopts::value<uint64_t>()->default_value("50"))
+        ("namespaces", "Number of subscribe namespaces", cxxopts::value<uint64_t>()->default_value("100"))
+        ("max_selected", "Max tracks selected per subscribe namespace", cxxopts::value<uint64_t>()->default_value("3"))
+        ("duration_s", "Simulated duration in seconds", cxxopts::value<uint64_t>()->default_value("30"))
+        ("ranking_interval_ms", "Ranking batch interval in milliseconds, zero updates ranking on each sample",
+            cxxopts::value<uint64_t>()->default_value("10"))
+        ("ranking_hysteresis", "Value margin a track must exceed a selected top-n track by to replace it",
+            cxxopts::value<uint64_t>()->default_value("0"))
+        ("ranking_min_dwell_ms", "Minimum time in milliseconds a top-n track stays selected",
+            cxxopts::value<uint64_t>()->default_value("0"))
+        ("talk_start", "Chance per update that a silent track starts talking",
+            cxxopts::value<double>()->default_value("0.002"))
+        ("talk_stop", "Chance per update that a talking track stops talking",
+            cxxopts::value<double>()->default_value("0.01"))
+        ("seed", "Random seed", cxxopts::value<uint64_t>()->default_value("1"));
+    // clang-format on
+
+    auto result = options.parse(argc, argv);
+
+    if (result.count("help")) {
+        std::cout << options.help() << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    const auto num_tracks = result["tracks"].as<uint64_t>();
+    const auto rate = std::max<uint64_t>(result["rate"].as<uint64_t>(), 1);
+    const auto num_namespaces = result["namespaces"].as<uint64_t>();
+    const auto max_selected = std::max<uint64_t>(result["max_selected"].as<uint64_t>(), 1);
+    const auto duration_ms = result["duration_s"].as<uint64_t>() * 1000;
+    const auto interval_ms = result["ranking_interval_ms"].as<uint64_t>();
+    const auto talk_start = result["talk_start"].as<double>();
+    const auto talk_stop = result["talk_stop"].as<double>();
+    const uint64_t update_ms = std::max<uint64_t>(1000 / rate, 1);
+    constexpr uint64_t kAudioLevelProperty = 0x10;
+    constexpr uint64_t kInactiveAgeMs = 5000;
+
+    // Handlers log each track pause/publish at info level
+    spdlog::set_level(spdlog::level::warn);
+
+    auto tick_service = std::make_shared<SimTickService>();
+    std::mt19937_64 rng(result["seed"].as<uint64_t>());
+
+    const auto name_space = quicr::TrackNamespace{ "bench"s, "meeting"s };
+
+    std::vector<quicr::messages::TrackAlias> track_aliases;
+    for (uint64_t i = 0; i < num_tracks; ++i) {
+        const auto name = "audio-" + std::to_string(i);
+        const quicr::FullTrackName full_track_name{ name_space, { name.begin(), name.end() } };
+        track_aliases.push_back(quicr::TrackHash(full_track_name).track_fullname_hash);
+    }
+
+    auto ranking = std::make_shared<laps::TrackRanking>();
+    ranking->SetInactiveAge(kInactiveAgeMs);
+    ranking->SetMaxSelected(max_selected + max_selected / 2);
+
+    std::vector<std::shared_ptr<laps::PublishNamespaceHandler>> handlers;
+    for (uint64_t n = 0; n < num_namespaces; ++n) {
+        auto handler = laps::PublishNamespaceHandler::Create(name_space, tick_service);
+        handler->SetMaxSelected(max_selected);
+        handler->SetInactiveAge(kInactiveAgeMs);
+        handler->SetPropertyType(kAudioLevelProperty);
+        handler->SetHysteresis(result["ranking_hysteresis"].as<uint64_t>());
+        handler->SetMinDwell(result["ranking_min_dwell_ms"].as<uint64_t>());
+
+        for (uint64_t i = 0; i < num_tracks; ++i) {
+            const auto name = "audio-" + std::to_string(i);
+            auto pub_handler = std::make_shared<SimPublishTrackHandler>(
+              quicr::FullTrackName{ name_space, { name.begin(), name.end() } });
+            handler->PublishTrack(pub_handler);
+
+            // Tracks are published paused and start when selected, same as the relay namespace publish flow
+            pub_handler->Pause();
+        }
+
+        ranking->AddNamespaceHandler(handler);
+        handlers.push_back(std::move(handler));
+    }
+
+    std::cout << "Tracks: " << num_tracks << " rate: " << rate << "/s namespaces: " << num_namespaces
+              << " max selected: " << max_selected << " duration: " << duration_ms / 1000
+              << " s ranking interval: " << interval_ms << " ms" << std::endl;
+
+    std::vector<AudioLevel> levels(num_tracks);
+    std::vector<uint64_t> update_latencies_ns;
+    std::vector<uint64_t> batch_latencies_ns;
+    std::size_t samples_applied = 0;
+    uint64_t next_batch_ms = interval_ms;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (uint64_t now_ms = 0; now_ms < duration_ms; now_ms += update_ms) {
+        tick_service->Set(now_ms);
+
+        for (uint64_t i = 0; i < num_tracks; ++i) {
+            const auto value = levels[i].Sample(rng, talk_start, talk_stop);
+
+            if (interval_ms == 0) {
+                const auto update_start = std::chrono::steady_clock::now();
+                ranking->UpdateValue(track_aliases[i], kAudioLevelProperty, value, now_ms, i + 1);
+                update_latencies_ns.push_back(static_cast<uint64_t>(
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - update_start)
+                    .count()));
+                samples_applied++;
+            } else {
+                const auto update_start = std::chrono::steady_clock::now();
+                ranking->QueueValue(track_aliases[i], kAudioLevelProperty, value, now_ms, i + 1);
+                update_latencies_ns.push_back(static_cast<uint64_t>(
+                  std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - update_start)
+                    .count()));
+            }
+        }
+
+        // Same as the client manager ranking thread
+        while (interval_ms > 0 && now_ms + update_ms > next_batch_ms) {
+            const auto batch_start = std::chrono::steady_clock::now();
+            samples_applied += ranking->ProcessQueued();
+            ranking->Expire(next_batch_ms);
+            batch_latencies_ns.push_back(static_cast<uint64_t>(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - batch_start)
+                .count()));
+            next_batch_ms += interval_ms;
+        }
+    }
+
+    const auto elapsed =
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    PrintSummary(interval_ms == 0 ? "UpdateValue" : "QueueValue", Summarize(update_latencies_ns));
+    if (interval_ms > 0) {
+        PrintSummary("ProcessQueued", Summarize(batch_latencies_ns));
+    }
+
+    laps::PublishNamespaceHandler::SwitchMetrics switch_metrics;
+    std::size_t published = 0;
+    std::size_t unpublished = 0;
+    for (const auto& handler : handlers) {
+        const auto& metrics = handler->GetSwitchMetrics();
+        switch_metrics.switches += metrics.switches;
+        switch_metrics.avoided_hysteresis += metrics.avoided_hysteresis;
+        switch_metrics.avoided_dwell += metrics.avoided_dwell;
+        published += handler->GetPublishedCount();
+        unpublished += handler->GetUnpublishedCount();
+    }
+
+    const auto per_namespace = [&](uint64_t count) {
+        return num_namespaces ? static_cast<double>(count) / static_cast<double>(num_namespaces) : 0.0;
+    };
+
+    std::cout << "Samples applied: " << samples_applied << " elapsed: " << elapsed.count() << " ms" << std::endl;
+    std::cout << "Switches: " << switch_metrics.switches << " (" << per_namespace(switch_metrics.switches)
+              << " per namespace) avoided hysteresis: " << switch_metrics.avoided_hysteresis
+              << " avoided dwell: " << switch_metrics.avoided_dwell << std::endl;
+    std::cout << "Published tracks: " << published << " unpublished cached: " << unpublished << std::endl;
+
+    return EXIT_SUCCESS;
+}
@@ -27,6 +27,43 @@ namespace laps {
       , peer_manager_(peer_manager)
       , cache_duration_ms_(cache_duration_ms)
     {
+        ranking_thr_ = std::thread(&ClientManager::RankingThread, this);
+    }
+
+    ClientManager::~ClientManager()
+    {
+        stop_ = true;
+
+        if (ranking_thr_.joinable())
+            ranking_thr_.join();
+    }
+
+    void ClientManager::RankingThread()
+    {
+        const auto interval_ms =
+          config_.ranking_interval_ms > 0 ? config_.ranking_interval_ms : TrackRanking::kExpiryWheelSlotMs;
+
+        SPDLOG_LOGGER_INFO(LOGGER, "Running track ranking thread, interval: {} ms", interval_ms);
+
+        while (not stop_) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+
+            const auto tick = static_cast<uint64_t>(
+              std::chrono::duration_cast<std::chrono::milliseconds>(config_.tick_service_->get()).count());
+
+            std::vector<std::shared_ptr<TrackRanking>> rankings;
+            {
+                std::lock_guard _(rankings_mutex_);
+                for (const auto& ranking : track_rankings_ | std::views::values) {
+                    rankings.push_back(ranking);
+                }
+            }
+
+            for (const auto& ranking : rankings) {
+                ranking->ProcessQueued();
+                ranking->Expire(tick);
+            }
+        }
     }
 
     void ClientManager::NewConnectionAccepted(quicr::ConnectionHandle connection_handle,
@@ -41,7 +78,7 @@ namespace laps {
       uint64_t request_id)
     {
 
-        auto it = state_.requests.find({ connection_handle, request_id });
+        auto it = state_.requests.find({ request_id, connection_handle });
         if (it == state_.requests.end()) {
             SPDLOG_LOGGER_DEBUG(
               LOGGER,
@@ -57,19 +94,19 @@ namespace laps {
                             connection_handle,
                             request_id);
 
-        auto& track_namespace = std::any_cast<quicr::TrackNamespace&>(it->second.related_data);
+        auto& track_namespace = it->second.track_namespace;
         auto th = quicr::TrackHash({ track_namespace, {} });
 
         peer_manager_.ClientAnnounce({ track_namespace, {} }, {}, true, true);
 
-        // TODO: Fix O(prefix namespaces) matching
         std::vector<quicr::ConnectionHandle> sub_namespace_connections;
-        for (const auto& [ns, conns] : state_.subscribes_namespaces) {
-            if (!ns.HasSamePrefix(track_namespace)) {
+        for (const auto& ns : state_.subscribes_namespaces_index.Matching(track_namespace)) {
+            const auto ns_it = state_.subscribes_namespaces.find(ns);
+            if (ns_it == state_.subscribes_namespaces.end()) {
                 continue;
             }
 
-            for (auto conn_handle : std::views::keys(conns)) {
+            for (auto conn_handle : std::views::keys(ns_it->second)) {
                 SPDLOG_DEBUG("Received publish namespace done matches prefix subscribed from connection handle: {} for "
                              "namespace hash: {}",
                              conn_handle,
@@ -81,9 +118,16 @@ namespace laps {
 
         ResolvePublishNamespaceDone(connection_handle, request_id, sub_namespace_connections);
 
-        for (auto track_alias : state_.pub_namespace_active[{ track_namespace, connection_handle }]) {
-            auto ptd = state_.pub_subscribes[{ track_alias, connection_handle }];
-            if (ptd != nullptr) {
+        std::set<quicr::messages::TrackAlias> anno_tracks;
+        if (auto anno_it = state_.pub_namespace_active.find({ track_namespace, connection_handle });
+            anno_it != state_.pub_namespace_active.end()) {
+            anno_tracks = anno_it->second;
+        }
+
+        for (auto track_alias : anno_tracks) {
+            auto pub_it = state_.pub_subscribes.find({ track_alias, connection_handle });
+            if (pub_it != state_.pub_subscribes.end() && pub_it->second != nullptr) {
+                auto ptd = pub_it->second;
                 SPDLOG_LOGGER_INFO(
                   LOGGER,
                   "Received publish namespace done from connection handle: {0} for namespace hash: {1}, removing "
@@ -94,10 +138,10 @@ namespace laps {
 
                 UnsubscribeTrack(connection_handle, ptd);
             }
-            state_.pub_subscribes.erase({ track_alias, connection_handle });
+            state_.ErasePubSubscribe(track_alias, connection_handle);
         }
 
-        state_.pub_namespace_active.erase({ track_namespace, connection_handle });
+        state_.ErasePubNamespaceActive(track_namespace, connection_handle);
 
         if (connection_handle)
             peer_manager_.ClientUnannounce({ track_namespace, {} });
@@ -105,34 +149,56 @@ namespace laps {
         return sub_namespace_connections;
     }
 
+    std::shared_ptr<PublishTrackHandler> ClientManager::CreateNamespacePublishTrack(
+      const std::shared_ptr<SubscribeTrackHandler>& handler)
+    {
+        const auto& track_full_name = handler->GetFullTrackName();
+        std::optional<quicr::messages::Location> largest_location = GetLargestAvailable(track_full_name);
+
+        const auto pub_handler = PublishTrackHandler::Create(
+          track_full_name,
+          quicr::TrackMode::kStream,
+          handler->GetPriority(),
+          handler->GetDeliveryTimeout().value_or(std::chrono::milliseconds(kDefaultObjectTtl)).count(),
+          largest_location.value_or(quicr::messages::Location{ 0, 0 }),
+          *this);
+
+        if (!pub_handler->GetTrackAlias().has_value()) {
+            auto pub_th = quicr::TrackHash(track_full_name);
+            pub_handler->SetTrackAlias(pub_th.track_fullname_hash);
+        }
+
+        return pub_handler;
+    }
+
     void ClientManager::PurgePublishState(quicr::ConnectionHandle connection_handle)
     {
         std::lock_guard<std::mutex> _(state_.state_mutex);
 
-        std::vector<std::pair<quicr::messages::TrackAlias, quicr::ConnectionHandle>> pub_subs;
-        for (const auto& [key, _] : state_.pub_subscribes) {
-            if (key.second == connection_handle) {
-                pub_subs.push_back(key);
-            }
-        }
+        const auto& conn_track_aliases = state_.pub_subscribes.Ids(connection_handle);
+        const std::vector<quicr::messages::TrackAlias> pub_subs(conn_track_aliases.begin(), conn_track_aliases.end());
 
-        for (const auto& remove_key : pub_subs) {
-            state_.pub_subscribes.erase(remove_key);
+        for (const auto track_alias : pub_subs) {
+            state_.ErasePubSubscribe(track_alias, connection_handle);
             SPDLOG_LOGGER_DEBUG(LOGGER,
                                 "Purge publish state for track_alias: {} connection handle: {}",
-                                remove_key.first,
-                                remove_key.second);
+                                track_alias,
+                                connection_handle);
         }
 
-        std::vector<std::pair<quicr::TrackNamespace, quicr::ConnectionHandle>> anno_remove_list;
-        for (const auto& [key, _] : state_.pub_namespace_active) {
-            if (key.second == connection_handle) {
-                anno_remove_list.push_back(key);
-            }
+        for (const auto& name_space : state_.GetConnectionPubNamespaces(connection_handle)) {
+            state_.ErasePubNamespaceActive(name_space, connection_handle);
+        }
+
+        // Requests and publisher initiated subscribes of the connection
+        const auto& conn_request_ids = state_.requests.Ids(connection_handle);
+        for (const auto request_id : std::vector(conn_request_ids.begin(), conn_request_ids.end())) {
+            state_.requests.erase({ request_id, connection_handle });
         }
 
-        for (const auto& remove_key : anno_remove_list) {
-            state_.pub_namespace_active.erase(remove_key);
+        const auto& conn_pub_request_ids = state_.pub_subscribes_by_req_id.Ids(connection_handle);
+        for (const auto request_id : std::vector(conn_pub_request_ids.begin(), conn_pub_request_ids.end())) {
+            state_.pub_subscribes_by_req_id.erase({ request_id, connection_handle });
         }
     }
 
@@ -141,56 +207,58 @@ namespace laps {
                                                  const quicr::PublishNamespaceAttributes& attrs)
     {
 
-        auto [req_it, _] = state_.requests.try_emplace({ connection_handle, attrs.request_id },
+        auto [req_it, _] = state_.requests.try_emplace({ attrs.request_id, connection_handle },
                                                        State::RequestTransaction::Type::kPublishNamespace,
                                                        State::RequestTransaction::State::kOk);
-        req_it->second.related_data.emplace<quicr::TrackNamespace>(track_namespace);
+        req_it->second.track_namespace = track_namespace;
 
         auto subscribe_to_publisher = [&] {
-            auto& anno_tracks = state_.pub_namespace_active[{ track_namespace, connection_handle }];
+            auto& anno_tracks = state_.AddPubNamespaceActive(track_namespace, connection_handle);
 
             // Check if there are any subscribes. If so, send subscribe to announce for all tracks matching namespace
-            for (const auto& [ns, sub_tracks] : state_.subscribe_active_) {
-                if (!ns.first.HasSamePrefix(track_namespace)) {
-                    continue;
-                }
+            for (const auto& ns : state_.subscribe_active_index.Matching(track_namespace)) {
+                for (auto sa_it = state_.subscribe_active_.lower_bound({ ns, 0 });
+                     sa_it != state_.subscribe_active_.end() && sa_it->first.first == ns;
+                     ++sa_it) {
+                    const auto& sub_tracks = sa_it->second;
 
-                if (sub_tracks.empty()) {
-                    continue;
-                }
+                    if (sub_tracks.empty()) {
+                        continue;
+                    }
 
-                auto& a_si = *sub_tracks.begin();
-                if (anno_tracks.find(a_si.track_alias) == anno_tracks.end()) {
-                    SPDLOG_LOGGER_INFO(
-                      LOGGER,
-                      "Sending subscribe to announcer connection handle: {0} subscribe track_alias: {1}",
-                      connection_handle,
-                      a_si.track_alias);
+                    auto& a_si = *sub_tracks.begin();
+                    if (anno_tracks.find(a_si.track_alias) == anno_tracks.end()) {
+                        SPDLOG_LOGGER_INFO(
+                          LOGGER,
+                          "Sending subscribe to announcer connection handle: {0} subscribe track_alias: {1}",
+                          connection_handle,
+                          a_si.track_alias);
 
-                    anno_tracks.insert(a_si.track_alias); // Add track to state
+                        anno_tracks.insert(a_si.track_alias); // Add track to state
 
-                    const auto& sub_info_it = state_.subscribes.find({ a_si.track_alias, a_si.connection_handle });
-                    if (sub_info_it == state_.subscribes.end()) {
-                        continue;
-                    }
+                        const auto& sub_info_it = state_.subscribes.find({ a_si.track_alias, a_si.connection_handle });
+                        if (sub_info_it == state_.subscribes.end()) {
+                            continue;
+                        }
 
-                    const auto& sub_ftn = sub_info_it->second.track_full_name;
+                        const auto& sub_ftn = sub_info_it->second.track_full_name;
 
-                    // TODO(tievens): Don't really like passing self to subscribe handler, see about fixing this
-                    auto sub_track_handler =
-                      std::make_shared<SubscribeTrackHandler>(sub_ftn, 0, std::nullopt, *this, config_.tick_service_);
+                        // TODO(tievens): Don't really like passing self to subscribe handler, see about fixing this
+                        auto sub_track_handler = std::make_shared<SubscribeTrackHandler>(
+                          sub_ftn, 0, std::nullopt, *this, config_.tick_service_);
 
-                    // Add subsribers to publisher subscribe handler
-                    for (const auto& sub_info : sub_tracks) {
-                        sub_track_handler->AddSubscriber(sub_info.connection_handle,
-                                                         sub_info.request_id,
-                                                         sub_info.priority,
-                                                         sub_info.delivery_timeout,
-                                                         sub_info.start_location);
-                    }
+                        // Add subsribers to publisher subscribe handler
+                        for (const auto& sub_info : sub_tracks) {
+                            sub_track_handler->AddSubscriber(sub_info.connection_handle,
+                                                             sub_info.request_id,
+                                                             sub_info.priority,
+                                                             sub_info.delivery_timeout,
+                                                             sub_info.start_location);
+                        }
 
-                    SubscribeTrack(connection_handle, sub_track_handler);
-                    state_.pub_subscribes[{ a_si.track_alias, connection_handle }] = sub_track_handler;
+                        SubscribeTrack(connection_handle, sub_track_handler);
+                        state_.SetPubSubscribe(a_si.track_alias, connection_handle, sub_track_handler);
+                    }
                 }
             }
         };
@@ -217,20 +285,20 @@ namespace laps {
             return;
         }
 
-        state_.pub_namespace_active.try_emplace(std::make_pair(track_namespace, connection_handle));
+        state_.AddPubNamespaceActive(track_namespace, connection_handle);
 
         PublishNamespaceResponse announce_response;
         announce_response.reason_code = quicr::Server::PublishNamespaceResponse::ReasonCode::kOk;
 
         std::vector<quicr::ConnectionHandle> sub_annos_connections;
 
-        // TODO: Fix O(prefix namespaces) matching
-        for (const auto& [ns, conns] : state_.subscribes_namespaces) {
-            if (!ns.HasSamePrefix(track_namespace)) {
+        for (const auto& ns : state_.subscribes_namespaces_index.Matching(track_namespace)) {
+            const auto ns_it = state_.subscribes_namespaces.find(ns);
+            if (ns_it == state_.subscribes_namespaces.end()) {
                 continue;
             }
 
-            for (auto& [conn_handle, _] : conns) {
+            for (auto& [conn_handle, _] : ns_it->second) {
                 SPDLOG_DEBUG("Received publish namespace matches prefix subscribed namespace from connection handle: "
                              "{} for namespace hash: {}",
                              conn_handle,
@@ -275,10 +343,10 @@ namespace laps {
         publish_response.reason_code = quicr::PublishResponse::ReasonCode::kOk;
 
         // PublishTrack within publish namespace handler if matched
-        for (auto& [tn, conns] : state_.subscribes_namespaces) {
-            const auto prefix_match = tn.IsPrefixOf(publish_attributes.track_full_name.name_space);
-
-            if (prefix_match == std::partial_ordering::less || prefix_match == std::partial_ordering::equivalent) {
+        const auto& publish_ns = publish_attributes.track_full_name.name_space;
+        for (const auto& tn : state_.subscribes_namespaces_index.PrefixesOf(publish_ns)) {
+            if (auto ns_it = state_.subscribes_namespaces.find(tn); ns_it != state_.subscribes_namespaces.end()) {
+                auto& conns = ns_it->second;
 
                 SPDLOG_LOGGER_DEBUG(LOGGER,
                                     "Publish matches subscribe namespace track alias: {} request_id: {} tfn: {} ({})",
@@ -326,7 +394,7 @@ namespace laps {
             sub_track_handler->SupportNewGroupRequest(true);
         }
 
-        state_.pub_subscribes[{ th.track_fullname_hash, connection_handle }] = sub_track_handler;
+        state_.SetPubSubscribe(th.track_fullname_hash, connection_handle, sub_track_handler);
 
         if (!is_from_peer) {
             state_.pub_subscribes_by_req_id[{ request_id, connection_handle }] = sub_track_handler;
@@ -343,21 +411,26 @@ namespace laps {
 
         // Check if there are any subscribers
         bool has_subs{ peer_manager_.HasSubscribers(th.track_fullname_hash) };
-        for (auto it = state_.subscribes.lower_bound({ th.track_fullname_hash, 0 }); it != state_.subscribes.end();
-             ++it) {
-            if (it->first.first == th.track_fullname_hash) {
-                has_subs = true;
-                sub_track_handler->AddSubscriber(it->first.second,
-                                                 it->second.request_id,
-                                                 it->second.priority,
-                                                 std::chrono::milliseconds(it->second.object_ttl),
-                                                 it->second.start_location);
-            }
+        for (const auto sub_conn_handle : state_.subscribes.Connections(th.track_fullname_hash)) {
+            const auto& sub_info = state_.subscribes.at({ th.track_fullname_hash, sub_conn_handle });
+
+            has_subs = true;
+            sub_track_handler->AddSubscriber(sub_conn_handle,
+                                             sub_info.request_id,
+                                             sub_info.priority,
+                                             std::chrono::milliseconds(sub_info.object_ttl),
+                                             sub_info.start_location);
         }
 
         quicr::TrackNamespace sub_ns;
-        for (const auto& [ns_prefix, conns] : state_.subscribes_namespaces) {
-            if (ns_prefix.HasSamePrefix(publish_attributes.track_full_name.name_space) && !conns.empty()) {
+        for (const auto& ns_prefix : state_.subscribes_namespaces_index.Matching(publish_ns)) {
+            auto ns_it = state_.subscribes_namespaces.find(ns_prefix);
+            if (ns_it == state_.subscribes_namespaces.end()) {
+                continue;
+            }
+
+            const auto& conns = ns_it->second;
+            if (!conns.empty()) {
                 has_subs = true;
 
                 if (sub_ns.empty()) {
@@ -371,9 +444,12 @@ namespace laps {
         }
 
         auto ns_th = quicr::TrackHash({ sub_ns, {} });
-        auto rank_it = track_rankings_.find(ns_th.track_namespace_hash);
-        if (rank_it != track_rankings_.end()) {
-            sub_track_handler->SetTrackRanking(rank_it->second);
+        {
+            std::lock_guard _(rankings_mutex_);
+            auto rank_it = track_rankings_.find(ns_th.track_namespace_hash);
+            if (rank_it != track_rankings_.end()) {
+                sub_track_handler->SetTrackRanking(rank_it->second);
+            }
         }
 
         if (!has_subs) {
@@ -393,12 +469,10 @@ namespace laps {
     {
         auto th = quicr::TrackHash({ prefix_namespace, {} });
 
-        auto [it, is_new] = state_.subscribes_namespaces.try_emplace(prefix_namespace);
-
         auto handler = PublishNamespaceHandler::Create(prefix_namespace, GetTickService());
         PublishNamespace(connection_handle, handler);
 
-        auto [pub_it, _] = it->second.emplace(connection_handle, handler);
+        auto [pub_it, is_new] = state_.AddSubscribesNamespace(prefix_namespace, connection_handle, handler);
 
         if (is_new) {
             SPDLOG_INFO(
@@ -408,11 +482,25 @@ namespace laps {
               prefix_namespace.Str());
         }
 
-        auto [ranks_it, __] = track_rankings_.try_emplace(th.track_namespace_hash, std::make_shared<TrackRanking>());
+        std::shared_ptr<TrackRanking> ranking;
+        {
+            std::lock_guard _(rankings_mutex_);
+            auto [ranks_it, __] = track_rankings_.try_emplace(th.track_namespace_hash);
+            if (ranks_it->second == nullptr) {
+                ranks_it->second = std::make_shared<TrackRanking>();
+            }
+            ranking = ranks_it->second;
+        }
 
         if (const auto* tf = std::get_if<quicr::messages::TrackFilter>(&attributes.filter)) {
-            if (ranks_it->second->GetInactiveAge() < tf->timeout) {
-                ranks_it->second->SetInactiveAge(tf->timeout);
+            if (ranking->GetInactiveAge() < tf->timeout) {
+                ranking->SetInactiveAge(tf->timeout);
+            }
+
+            // Ranking selects candidates with headroom for self-tracks that the handler filters out
+            const uint64_t max_candidates = tf->max_tracks_selected + tf->max_tracks_selected / 2;
+            if (ranking->GetMaxSelected() < max_candidates) {
+                ranking->SetMaxSelected(max_candidates);
             }
 
             SPDLOG_INFO("Subscribe namespace track filter: property_type={} max_tracks={} timeout={}ms",
@@ -422,69 +510,66 @@ namespace laps {
             handler->SetMaxSelected(tf->max_tracks_selected);
             handler->SetInactiveAge(tf->timeout);
             handler->SetPropertyType(tf->property_type);
+            handler->SetHysteresis(config_.ranking_hysteresis);
+            handler->SetMinDwell(config_.ranking_min_dwell_ms);
         } else {
             SPDLOG_INFO("Subscribe namespace has no track filter, using defaults");
         }
 
-        ranks_it->second->AddNamespaceHandler(handler);
+        // Recreates the publish track of a ranked track that was unpublished after it was demoted. Called by the
+        // track ranking with the ranking and handler mutexes held, state mutex is taken last (lock order)
+        handler->SetPublishTrackFactory(
+          [this](quicr::messages::TrackAlias track_alias,
+                 uint64_t connection_id) -> std::shared_ptr<quicr::PublishTrackHandler> {
+              std::lock_guard _(state_.state_mutex);
 
-        std::vector<quicr::TrackNamespace> matched_ns;
+              const auto pub_sub_it = state_.pub_subscribes.find({ track_alias, connection_id });
+              if (pub_sub_it == state_.pub_subscribes.end() || !pub_sub_it->second) {
+                  return nullptr;
+              }
 
-        // TODO: Fix O(prefix namespaces) matching
-        for (const auto& [key, _] : state_.pub_namespace_active) {
-            // Add matching announced namespaces to vector without duplicates
-            const auto prefix_match = prefix_namespace.IsPrefixOf(key.first);
-            if ((prefix_match == std::partial_ordering::less || prefix_match == std::partial_ordering::equivalent) &&
-                (matched_ns.empty() || matched_ns.back() != key.first)) {
-                matched_ns.push_back(key.first);
-            }
-        }
+              return CreateNamespacePublishTrack(pub_sub_it->second);
+          });
+
+        ranking->AddNamespaceHandler(handler);
+
+        // Matching announced namespaces, each namespace is indexed once regardless of the number of connections
+        auto matched_ns = state_.pub_namespace_active_index.WithPrefix(prefix_namespace);
 
         const quicr::SubscribeNamespaceResponse response = { .reason_code =
                                                                quicr::SubscribeNamespaceResponse::ReasonCode::kOk,
                                                              .namespaces = std::move(matched_ns) };
         ResolveSubscribeNamespace(connection_handle, data_ctx_id, attributes.request_id, prefix_namespace, response);
 
-        // TODO: Need to change this to use what peering is using to prefix match instead of O(n) over all publish
-        //  subscribes
-        for (const auto& [ta_conn, handler] : state_.pub_subscribes) {
+        for (const auto& ta_conn : state_.GetPubSubscribesWithPrefix(prefix_namespace)) {
+            const auto pub_sub_it = state_.pub_subscribes.find(ta_conn);
+            if (pub_sub_it == state_.pub_subscribes.end()) {
+                continue;
+            }
+
+            const auto& handler = pub_sub_it->second;
             if (!handler || (!config_.allow_self && ta_conn.second == connection_handle)) {
                 continue;
             }
 
             const auto& track_full_name = handler->GetFullTrackName();
-            const auto prefix_match = prefix_namespace.IsPrefixOf(track_full_name.name_space);
-            if (prefix_match == std::partial_ordering::less || prefix_match == std::partial_ordering::equivalent) {
-                std::optional<quicr::messages::Location> largest_location = GetLargestAvailable(track_full_name);
-
-                /*
-                 * PublishTrack within the namespace handler determines if the track should be published or not
-                 * based on filters
-                 */
-                const auto pub_handler = PublishTrackHandler::Create(
-                  track_full_name,
-                  quicr::TrackMode::kStream,
-                  handler->GetPriority(),
-                  handler->GetDeliveryTimeout().value_or(std::chrono::milliseconds(kDefaultObjectTtl)).count(),
-                  largest_location.value_or(quicr::messages::Location{ 0, 0 }),
-                  *this);
-
-                if (!pub_handler->GetTrackAlias().has_value()) {
-                    auto pub_th = quicr::TrackHash(track_full_name);
-                    pub_handler->SetTrackAlias(pub_th.track_fullname_hash);
-                }
 
-                handler->AddSubscribeNamespace(pub_it->second);
-                handler->SetTrackRanking(ranks_it->second);
-                pub_it->second->PublishTrack(pub_handler);
+            /*
+             * PublishTrack within the namespace handler determines if the track should be published or not
+             * based on filters
+             */
+            const auto pub_handler = CreateNamespacePublishTrack(handler);
 
-                SPDLOG_LOGGER_DEBUG(
-                  LOGGER,
-                  "Matched PUBLISH track for SUBSCRIBE_NAMESPACE: conn: {} track_alias: {} track_hash: {}",
-                  connection_handle,
-                  ta_conn.first,
-                  quicr::TrackHash(track_full_name).track_fullname_hash);
-            }
+            handler->AddSubscribeNamespace(pub_it->second);
+            handler->SetTrackRanking(ranking);
+            pub_it->second->PublishTrack(pub_handler);
+
+            SPDLOG_LOGGER_DEBUG(
+              LOGGER,
+              "Matched PUBLISH track for SUBSCRIBE_NAMESPACE: conn: {} track_alias: {} track_hash: {}",
+              connection_handle,
+              ta_conn.first,
+              quicr::TrackHash(track_full_name).track_fullname_hash);
         }
     }
 
@@ -504,32 +589,35 @@ namespace laps {
         // Get the publish namespace handler by connection handle
         auto pub_it = it->second.find(connection_handle);
         if (pub_it == it->second.end()) {
-            if (it->second.empty()) {
-                state_.subscribes_namespaces.erase(it);
-            }
             return;
         }
 
-        // Loop through publishes and remove subscribe namespace
-        for (const auto& [ta_conn, handler] : state_.pub_subscribes) {
-            if (!handler || (!config_.allow_self && ta_conn.second == connection_handle)) {
+        // Loop through matching publishes and remove subscribe namespace
+        for (const auto& ta_conn : state_.GetPubSubscribesMatching(prefix_namespace)) {
+            // Removing or pausing a publisher subscribe may erase other entries
+            const auto pub_sub_it = state_.pub_subscribes.find(ta_conn);
+            if (pub_sub_it == state_.pub_subscribes.end()) {
                 continue;
             }
 
-            const auto& track_full_name = handler->GetFullTrackName();
-            const bool ns_matched = prefix_namespace.HasSamePrefix(track_full_name.name_space);
-            if (ns_matched) {
-                handler->RemoveSubscribeNamespace(pub_it->second);
-                track_rankings_[th.track_namespace_hash]->RemoveNamespaceHandler(pub_it->second);
+            const auto handler = pub_sub_it->second;
+            if (!handler || (!config_.allow_self && ta_conn.second == connection_handle)) {
+                continue;
+            }
 
-                RemoveOrPausePublisherSubscribe(ta_conn.first);
+            handler->RemoveSubscribeNamespace(pub_it->second);
+            {
+                std::lock_guard _(rankings_mutex_);
+                if (auto rank_it = track_rankings_.find(th.track_namespace_hash); rank_it != track_rankings_.end()) {
+                    rank_it->second->RemoveNamespaceHandler(pub_it->second);
+                }
             }
-        }
 
-        it->second.erase(pub_it);
+            RemoveOrPausePublisherSubscribe(ta_conn.first);
+        }
 
-        if (it->second.empty()) {
-            state_.subscribes_namespaces.erase(it);
+        if (state_.EraseSubscribesNamespace(prefix_namespace, connection_handle)) {
+            std::lock_guard _(rankings_mutex_);
             track_rankings_.erase(th.track_namespace_hash);
         }
     }
@@ -554,33 +642,22 @@ namespace laps {
                 break;
         }
 
-        // Remove all subscribe announces for this connection handle
-        std::vector<quicr::TrackNamespace> remove_ns;
-        for (auto& [ns, conns] : state_.subscribes_namespaces) {
-            auto it = conns.find(connection_handle);
-            if (it != conns.end()) {
-                remove_ns.emplace_back(ns);
-            }
+        {
+            std::lock_guard _(egress_mutex_);
+            egress_rate_bps_.erase(connection_handle);
         }
 
-        for (auto ns : remove_ns) {
+        // Remove all subscribe announces for this connection handle
+        for (const auto& ns : state_.GetConnectionSubscribesNamespaces(connection_handle)) {
             UnsubscribeNamespaceReceived(connection_handle, ns);
         }
 
         // Clean up subscribe states
-        std::vector<std::pair<quicr::ConnectionHandle, quicr::messages::RequestID>> unsub_list;
-        for (auto it = state_.subscribe_alias_req_id.lower_bound({ connection_handle, 0 });
-             it != state_.subscribe_alias_req_id.end();
-             it++) {
-            const auto& [key, _] = *it;
-            if (key.first != connection_handle)
-                break;
+        const auto& conn_req_ids = state_.subscribe_alias_req_id.Ids(connection_handle);
+        const std::vector<quicr::messages::RequestID> unsub_list(conn_req_ids.begin(), conn_req_ids.end());
 
-            unsub_list.push_back(key);
-        }
-
-        for (auto& key : unsub_list) {
-            UnsubscribeReceived(key.first, key.second);
+        for (const auto request_id : unsub_list) {
+            UnsubscribeReceived(connection_handle, request_id);
         }
 
         // Cleanup publish states
@@ -619,20 +696,9 @@ namespace laps {
 
         auto th = quicr::TrackHash(s_it->second->GetFullTrackName());
 
-        state_.pub_subscribes.erase({ th.track_fullname_hash, connection_handle });
+        state_.ErasePubSubscribe(th.track_fullname_hash, connection_handle);
 
-        bool have_publishers{ false };
-        for (auto it = state_.pub_subscribes.lower_bound({ th.track_fullname_hash, 0 });
-             it != state_.pub_subscribes.end();
-             ++it) {
-
-            if (it->first.first != th.track_fullname_hash) {
-                break;
-            }
-
-            have_publishers = true;
-            break;
-        }
+        const bool have_publishers = !state_.pub_subscribes.Connections(th.track_fullname_hash).empty();
 
         std::vector<std::pair<quicr::ConnectionHandle, quicr::messages::RequestID>> unsub_list;
 
@@ -642,20 +708,16 @@ namespace laps {
 
             if (!config_.detached_subs) {
                 // Find subscribers that match this publisher and unsubscribe
-                for (auto it = state_.subscribes.lower_bound({ th.track_fullname_hash, 0 });
-                     it != state_.subscribes.end();
-                     ++it) {
-                    if (it->first.first != th.track_fullname_hash) {
-                        break;
-                    }
+                for (const auto sub_conn_handle : state_.subscribes.Connections(th.track_fullname_hash)) {
+                    const auto& sub_info = state_.subscribes.at({ th.track_fullname_hash, sub_conn_handle });
 
                     SPDLOG_LOGGER_INFO(LOGGER,
                                        "No publishers left, unsubscribe conn_id: {} track_alias: {} request_id: {}",
-                                       it->first.second,
-                                       it->second.track_alias,
-                                       it->second.request_id);
+                                       sub_conn_handle,
+                                       sub_info.track_alias,
+                                       sub_info.request_id);
 
-                    unsub_list.emplace_back(it->first.second, it->second.request_id);
+                    unsub_list.emplace_back(sub_conn_handle, sub_info.request_id);
                 }
 
                 lock.unlock();
@@ -674,7 +736,7 @@ namespace laps {
     {
         SPDLOG_LOGGER_INFO(LOGGER, "Unsubscribe connection handle: {0} request_id: {1}", connection_handle, request_id);
 
-        const auto ta_it = state_.subscribe_alias_req_id.find({ connection_handle, request_id });
+        const auto ta_it = state_.subscribe_alias_req_id.find({ request_id, connection_handle });
         if (ta_it == state_.subscribe_alias_req_id.end()) {
             SPDLOG_WARN(
               "Unable to find track alias for connection handle: {0} request_id: {1}", connection_handle, request_id);
@@ -700,24 +762,17 @@ namespace laps {
         auto th = quicr::TrackHash(sub_it->second.track_full_name);
 
         // Remove subscribe from publisher subscribe handler
-        for (auto it = state_.pub_subscribes.lower_bound({ th.track_fullname_hash, 0 });
-             it != state_.pub_subscribes.end();
-             ++it) {
-            const auto& [key, sub_to_pub_handler] = *it;
-            const auto& [track_alias, pub_conn_handle] = key;
-
-            if (track_alias != th.track_fullname_hash)
-                break;
-
-            sub_to_pub_handler->RemoveSubscriber(connection_handle);
+        for (const auto pub_conn_handle : state_.pub_subscribes.Connections(th.track_fullname_hash)) {
+            state_.pub_subscribes.at({ th.track_fullname_hash, pub_conn_handle })->RemoveSubscriber(connection_handle);
         }
 
-        auto& sub_active_list =
-          state_.subscribe_active_[{ sub_it->second.track_full_name.name_space, th.track_name_hash }];
-        sub_active_list.erase(State::SubscribeInfo{ connection_handle, request_id, th.track_fullname_hash });
+        auto sa_it = state_.subscribe_active_.find({ sub_it->second.track_full_name.name_space, th.track_name_hash });
+        if (sa_it != state_.subscribe_active_.end()) {
+            sa_it->second.erase(State::SubscribeInfo{ connection_handle, request_id, th.track_fullname_hash });
 
-        if (sub_active_list.empty()) {
-            state_.subscribe_active_.erase({ sub_it->second.track_full_name.name_space, th.track_name_hash });
+            if (sa_it->second.empty()) {
+                state_.EraseSubscribeActive(sub_it->second.track_full_name.name_space, th.track_name_hash);
+            }
         }
 
         state_.subscribes.erase(sub_it);
@@ -735,12 +790,10 @@ namespace laps {
         bool has_subs{ false };
 
         std::vector<std::pair<quicr::messages::TrackAlias, quicr::ConnectionHandle>> remove_sub_pub;
-        for (auto it = state_.pub_subscribes.lower_bound({ track_fullname_hash, 0 }); it != state_.pub_subscribes.end();
-             ++it) {
-            const auto& [key, sub_to_pub_handler] = *it;
-
-            if (key.first != track_fullname_hash)
-                break;
+        for (const auto pub_conn_handle : state_.pub_subscribes.Connections(track_fullname_hash)) {
+            const std::pair<quicr::messages::TrackAlias, quicr::ConnectionHandle> key{ track_fullname_hash,
+                                                                                       pub_conn_handle };
+            const auto sub_to_pub_handler = state_.pub_subscribes.at(key);
 
             if (sub_to_pub_handler->HasSubscribers()) {
                 has_subs = true;
@@ -768,7 +821,7 @@ namespace laps {
         }
 
         for (const auto& key : remove_sub_pub) {
-            state_.pub_subscribes.erase(key);
+            state_.ErasePubSubscribe(key.first, key.second);
         }
 
         if (!has_subs) {
@@ -790,20 +843,14 @@ namespace laps {
 
         const auto largest = GetLargestAvailable(track_full_name);
 
-        for (auto it = state_.pub_subscribes.lower_bound({ th.track_fullname_hash, 0 });
-             it != state_.pub_subscribes.end();
-             ++it) {
-
-            if (it->first.first != th.track_fullname_hash) {
-                break;
-            }
-
-            if (it->first.second != connection_handle) {
+        for (const auto pub_conn_handle : state_.pub_subscribes.Connections(th.track_fullname_hash)) {
+            if (pub_conn_handle != connection_handle) {
+                const auto& sub_to_pub_handler = state_.pub_subscribes.at({ th.track_fullname_hash, pub_conn_handle });
                 ResolveTrackStatus(connection_handle,
                                    request_id,
                                    {
                                      quicr::RequestResponse::ReasonCode::kOk,
-                                     it->second->IsPublisherInitiated(),
+                                     sub_to_pub_handler->IsPublisherInitiated(),
                                      std::nullopt,
                                      largest,
                                    });
@@ -974,19 +1021,11 @@ namespace laps {
                 // TODO: Add peering support
                 {
                     std::lock_guard _(state_.state_mutex);
-                    for (auto it = state_.pub_subscribes.lower_bound({ th.track_fullname_hash, 0 });
-                         it != state_.pub_subscribes.end();
-                         ++it) {
-                        auto& track_alias = it->first.first;
-                        auto& pub_conn_id = it->first.second;
-
-                        if (track_alias != th.track_fullname_hash) {
-                            rc = quicr::FetchResponse::ReasonCode::kNoObjects;
-                            break;
-                        }
-
-                        pub_connection_handle = pub_conn_id;
-                        break; // TODO: Support multiple publishers
+                    const auto& pub_conn_handles = state_.pub_subscribes.Connections(th.track_fullname_hash);
+                    if (pub_conn_handles.empty()) {
+                        rc = quicr::FetchResponse::ReasonCode::kNoObjects;
+                    } else {
+                        pub_connection_handle = *pub_conn_handles.begin(); // TODO: Support multiple publishers
                     }
                 }
 
@@ -1167,22 +1206,15 @@ namespace laps {
                                             });
 
         // Notify all publishers that there is a new group request
-        for (auto it = state_.pub_subscribes.lower_bound({ th.track_fullname_hash, 0 });
-             it != state_.pub_subscribes.end();
-             ++it) {
-            auto& track_alias = it->first.first;
-            auto& pub_conn_id = it->first.second;
+        for (const auto pub_conn_handle : state_.pub_subscribes.Connections(th.track_fullname_hash)) {
+            const auto& sub_to_pub_handler = state_.pub_subscribes.at({ th.track_fullname_hash, pub_conn_handle });
 
-            if (track_alias != th.track_fullname_hash) {
-                break;
-            }
+            if (!sub_to_pub_handler->GetPendingNewRquestId().has_value() ||
+                (group_id == 0 && *sub_to_pub_handler->GetPendingNewRquestId()) ||
+                *sub_to_pub_handler->GetPendingNewRquestId() < group_id) {
 
-            if (!it->second->GetPendingNewRquestId().has_value() ||
-                (group_id == 0 && *it->second->GetPendingNewRquestId()) ||
-                *it->second->GetPendingNewRquestId() < group_id) {
-
-                it->second->SetNewGroupRequestId(group_id);
-                DampenOrUpdateTrackSubscription(it->second, true);
+                sub_to_pub_handler->SetNewGroupRequestId(group_id);
+                DampenOrUpdateTrackSubscription(sub_to_pub_handler, true);
             }
         }
     }
@@ -1268,14 +1300,14 @@ namespace laps {
                                start_location.object);
 
             // record subscribe as active from this subscriber
-            state_.subscribe_active_[{ track_full_name.name_space, th.track_name_hash }].emplace(
-              State::SubscribeInfo{ connection_handle,
-                                    request_id,
-                                    th.track_fullname_hash,
-                                    attrs.priority,
-                                    attrs.delivery_timeout,
-                                    attrs.start_location });
-            state_.subscribe_alias_req_id[{ connection_handle, request_id }] = th.track_fullname_hash;
+            auto& sub_active_list = state_.AddSubscribeActive(track_full_name.name_space, th.track_name_hash);
+            sub_active_list.emplace(State::SubscribeInfo{ connection_handle,
+                                                          request_id,
+                                                          th.track_fullname_hash,
+                                                          attrs.priority,
+                                                          attrs.delivery_timeout,
+                                                          attrs.start_location });
+            state_.subscribe_alias_req_id[{ request_id, connection_handle }] = th.track_fullname_hash;
 
             auto [sub_it, _] = state_.subscribes.try_emplace(
               { th.track_fullname_hash, connection_handle },
@@ -1306,60 +1338,63 @@ namespace laps {
         }
 
         // Resume publisher initiated subscribes
-        for (auto it = state_.pub_subscribes.lower_bound({ th.track_fullname_hash, 0 });
-             it != state_.pub_subscribes.end();
-             ++it) {
-            if (it->first.first != th.track_fullname_hash) {
-                break;
-            }
-            if (it->second->IsPublisherInitiated()) {
-                it->second->Resume();
+        for (const auto pub_conn_handle : state_.pub_subscribes.Connections(th.track_fullname_hash)) {
+            const auto& sub_to_pub_handler = state_.pub_subscribes.at({ th.track_fullname_hash, pub_conn_handle });
+
+            if (sub_to_pub_handler->IsPublisherInitiated()) {
+                sub_to_pub_handler->Resume();
             }
 
-            it->second->AddSubscriber(
+            sub_to_pub_handler->AddSubscriber(
               connection_handle, request_id, attrs.priority, attrs.delivery_timeout, attrs.start_location);
 
-            DampenOrUpdateTrackSubscription(it->second, attrs.new_group_request_id.has_value());
+            DampenOrUpdateTrackSubscription(sub_to_pub_handler, attrs.new_group_request_id.has_value());
         }
 
         // Subscribe to announcer if announcer is active
-        for (auto& [key, track_aliases] : state_.pub_namespace_active) {
-            if (!key.first.HasSamePrefix(track_full_name.name_space) || !key.second) {
-                continue;
-            }
-
-            // if we have already forwarded subscription for the track alias
-            // don't forward unless we have expired the refresh period
-            auto pub_handler_it = state_.pub_subscribes.find({ th.track_fullname_hash, key.second });
-            if (pub_handler_it == state_.pub_subscribes.end()) {
-                SPDLOG_LOGGER_INFO(LOGGER,
-                                   "Sending subscribe to announcer connection handler: {0} subscribe track_alias: {1}",
-                                   key.second,
-                                   th.track_fullname_hash);
-
-                track_aliases.insert(th.track_fullname_hash); // Add track alias to state
-                auto sub_track_h =
-                  std::make_shared<SubscribeTrackHandler>(track_full_name,
-                                                          0 /* use zero to indicate to use publisher priority */,
-                                                          quicr::messages::GroupOrder::kAscending,
-                                                          *this,
-                                                          config_.tick_service_);
-                SubscribeTrack(key.second, sub_track_h);
-
-                sub_track_h->AddSubscriber(
-                  connection_handle, request_id, attrs.priority, attrs.delivery_timeout, attrs.start_location);
-
-                state_.pub_subscribes_by_req_id[{ sub_track_h->GetRequestId().value(), key.second }] = sub_track_h;
-                state_.pub_subscribes[{ th.track_fullname_hash, key.second }] = sub_track_h;
-
-                if (attrs.new_group_request_id) {
-                    sub_track_h->RequestNewGroup();
+        for (const auto& ns : state_.pub_namespace_active_index.Matching(track_full_name.name_space)) {
+            for (auto pna_it = state_.pub_namespace_active.lower_bound({ ns, 0 });
+                 pna_it != state_.pub_namespace_active.end() && pna_it->first.first == ns;
+                 ++pna_it) {
+                auto& [key, track_aliases] = *pna_it;
+                if (!key.second) {
+                    continue;
                 }
 
-            } else {
+                // if we have already forwarded subscription for the track alias
+                // don't forward unless we have expired the refresh period
                 auto pub_handler_it = state_.pub_subscribes.find({ th.track_fullname_hash, key.second });
-                if (pub_handler_it != state_.pub_subscribes.end()) {
-                    DampenOrUpdateTrackSubscription(pub_handler_it->second, attrs.new_group_request_id.has_value());
+                if (pub_handler_it == state_.pub_subscribes.end()) {
+                    SPDLOG_LOGGER_INFO(
+                      LOGGER,
+                      "Sending subscribe to announcer connection handler: {0} subscribe track_alias: {1}",
+                      key.second,
+                      th.track_fullname_hash);
+
+                    track_aliases.insert(th.track_fullname_hash); // Add track alias to state
+                    auto sub_track_h =
+                      std::make_shared<SubscribeTrackHandler>(track_full_name,
+                                                              0 /* use zero to indicate to use publisher priority */,
+                                                              quicr::messages::GroupOrder::kAscending,
+                                                              *this,
+                                                              config_.tick_service_);
+                    SubscribeTrack(key.second, sub_track_h);
+
+                    sub_track_h->AddSubscriber(
+                      connection_handle, request_id, attrs.priority, attrs.delivery_timeout, attrs.start_location);
+
+                    state_.pub_subscribes_by_req_id[{ sub_track_h->GetRequestId().value(), key.second }] = sub_track_h;
+                    state_.SetPubSubscribe(th.track_fullname_hash, key.second, sub_track_h);
+
+                    if (attrs.new_group_request_id) {
+                        sub_track_h->RequestNewGroup();
+                    }
+
+                } else {
+                    auto pub_handler_it = state_.pub_subscribes.find({ th.track_fullname_hash, key.second });
+                    if (pub_handler_it != state_.pub_subscribes.end()) {
+                        DampenOrUpdateTrackSubscription(pub_handler_it->second, attrs.new_group_request_id.has_value());
+                    }
                 }
             }
         }
@@ -1367,14 +1402,8 @@ namespace laps {
 
     void ClientManager::PeerUnsubscribeTrack(quicr::TrackFullNameHash track_full_name_hash)
     {
-        for (auto it = state_.pub_subscribes.lower_bound({ track_full_name_hash, 0 });
-             it != state_.pub_subscribes.end();
-             ++it) {
-            if (it->first.first != track_full_name_hash) {
-                break;
-            }
-
-            it->second->RemoveSubscriber(0);
+        for (const auto pub_conn_handle : state_.pub_subscribes.Connections(track_full_name_hash)) {
+            state_.pub_subscribes.at({ track_full_name_hash, pub_conn_handle })->RemoveSubscriber(0);
         }
     }
 
@@ -1419,5 +1448,20 @@ namespace laps {
                             metrics.quic.srtt_us.max,
                             metrics.quic.tx_rate_bps.max,
                             metrics.quic.tx_lost_pkts);
+
+        std::lock_guard _(egress_mutex_);
+        egress_rate_bps_[connection_handle] = metrics.quic.tx_rate_bps.avg;
+    }
+
+    uint64_t ClientManager::EgressRateBps()
+    {
+        std::lock_guard _(egress_mutex_);
+
+        uint64_t rate_bps{ 0 };
+        for (const auto& [connection_handle, conn_rate_bps] : egress_rate_bps_) {
+            rate_bps += conn_rate_bps;
+        }
+
+        return rate_bps;
     }
 }
@@ -7,8 +7,10 @@
 #include <quicr/cache.h>
 #include <quicr/server.h>
 
+#include <atomic>
 #include <functional>
 #include <set>
+#include <thread>
 
 namespace laps {
     /**
@@ -55,6 +57,7 @@ namespace laps {
                       const quicr::ServerConfig& cfg,
                       peering::PeerManager& peer_manager,
                       size_t cache_duration_ms = 60000);
+        ~ClientManager();
 
         void NewConnectionAccepted(quicr::ConnectionHandle connection_handle,
                                    const ConnectionRemoteInfo& remote) override;
@@ -137,9 +140,30 @@ namespace laps {
         void MetricsSampled(const quicr::ConnectionHandle connection_handle,
                             const quicr::ConnectionMetrics& metrics) override;
 
+        /**
+         * @brief Get the total egress transmit rate of client connections
+         * @returns Sum of the last sampled transmit rate in bits per second of all client connections
+         */
+        uint64_t EgressRateBps();
+
       private:
         void PurgePublishState(quicr::ConnectionHandle connection_handle);
 
+        /**
+         * @brief Create the publish track for a subscribe namespace of a track published to this relay
+         *
+         * @param handler           Subscribe handler towards the publisher of the track
+         */
+        std::shared_ptr<PublishTrackHandler> CreateNamespacePublishTrack(
+          const std::shared_ptr<SubscribeTrackHandler>& handler);
+
+        /**
+         * @brief Track ranking worker thread
+         * @details Applies queued ranking values of all track rankings in batches every ranking interval
+         *      and expires inactive tracks using the tick service, so that tracks expire without updates.
+         */
+        void RankingThread();
+
         void FetchReceived(quicr::ConnectionHandle connection_handle,
                            uint64_t request_id,
                            const quicr::FullTrackName& track_full_name,
@@ -152,6 +176,9 @@ namespace laps {
         const Config& config_;
         peering::PeerManager& peer_manager_;
 
+        std::mutex egress_mutex_;
+        std::map<quicr::ConnectionHandle, uint64_t> egress_rate_bps_; ///< Last sampled transmit rate by connection
+
         /**
          * @brief Map of atomic bools to mark if a fetch thread should be interrupted.
          */
@@ -160,8 +187,12 @@ namespace laps {
         size_t cache_duration_ms_ = 0;
         std::map<quicr::TrackFullNameHash, quicr::Cache<quicr::messages::GroupId, std::set<CacheObject>>> cache_;
 
+        std::mutex rankings_mutex_;
         std::unordered_map<quicr::TrackNamespaceHash, std::shared_ptr<TrackRanking>> track_rankings_;
 
+        std::atomic_bool stop_{ false };
+        std::thread ranking_thr_;
+
         friend class SubscribeTrackHandler;
         friend class PublishTrackHandler;
         friend class FetchTrackHandler;
@@ -15,12 +15,18 @@ namespace laps {
     constexpr uint16_t kDefaultPeerPort = 33434;
     constexpr uint64_t kDefaultPeerCheckIntervalMs = 5'000;
     constexpr uint32_t kDefaultPeerInitQueueSize = 5'000;
+    constexpr uint32_t kDefaultPeerCoalesceMaxBytes = 1'200;
+    constexpr uint32_t kDefaultPeerMultipathSrttMarginUs = 5'000;
+    constexpr uint32_t kDefaultPeerReconnectMinMs = 250;
+    constexpr uint32_t kDefaultPeerReconnectMaxMs = 30'000;
+    constexpr uint32_t kDefaultPeerUnsubscribeHolddownMs = 0;
     constexpr uint32_t kDefaultObjectTtl = 5'000;
     constexpr uint8_t kDefaultPriority = 10;
     constexpr uint32_t kDefaultCacheTimeQueueMaxDuration = 10'000;
     constexpr uint32_t kDefaultCacheTimeQueueObjectTtl = 6'000;
     constexpr uint32_t kDefaultSubscriptionRefreshIntervalMs = 500;
     constexpr uint32_t kFetchUpstreamMaxWaitMs = 2000;
+    constexpr uint32_t kDefaultRankingIntervalMs = 10;
 
     class Config
     {
@@ -42,6 +48,11 @@ namespace laps {
         uint32_t object_ttl_;
         uint32_t sub_dampen_ms_;
 
+        /// Track ranking worker batch interval in milliseconds, zero updates ranking on object receive
+        uint32_t ranking_interval_ms{ kDefaultRankingIntervalMs };
+        uint64_t ranking_hysteresis{ 0 };   /// Value margin to replace a selected top-n track, zero disables
+        uint32_t ranking_min_dwell_ms{ 0 }; /// Min time a top-n track stays selected in milliseconds, zero disables
+
         peering::NodeType node_type{ peering::NodeType::kEdge }; /// Node type of the relay
 
         std::shared_ptr<timeq::threaded_tick_service> tick_service_;
@@ -55,6 +66,18 @@ namespace laps {
             uint64_t check_interval_ms{ kDefaultPeerCheckIntervalMs }; /// Peer check interval in milliseconds
             uint32_t init_queue_size{ kDefaultPeerInitQueueSize };
 
+            uint32_t coalesce_window_us{ 0 }; /// Egress stream data coalesce window in microseconds, zero disables
+            uint32_t coalesce_max_bytes{ kDefaultPeerCoalesceMaxBytes }; /// Max bytes of coalesced stream data
+
+            uint32_t multipath_max_paths{ 1 }; /// Max equal cost peer sessions per node, one disables multipath
+            uint32_t multipath_srtt_margin_us{ kDefaultPeerMultipathSrttMarginUs }; /// Equal cost sum sRTT margin
+
+            uint32_t reconnect_min_ms{ kDefaultPeerReconnectMinMs }; /// Initial reconnect backoff in milliseconds
+            uint32_t reconnect_max_ms{ kDefaultPeerReconnectMaxMs }; /// Maximum reconnect backoff in milliseconds
+
+            /// Delay in milliseconds before withdrawing the last local subscribe of a track, zero disables
+            uint32_t unsubscribe_holddown_ms{ kDefaultPeerUnsubscribeHolddownMs };
+
         } peering;
 
         // constructor
@@ -3,6 +3,7 @@
 
 #include "config.h"
 
+#include <algorithm>
 #include <condition_variable>
 #include <cxxopts.hpp>
 #include <filesystem>
@@ -71,6 +72,37 @@ InitConfig(cxxopts::ParseResult& cli_opts, Config& cfg)
         }
     }
 
+    if (cli_opts.count("peer_coalesce_us")) {
+        cfg.peering.coalesce_window_us = cli_opts["peer_coalesce_us"].as<uint32_t>();
+        cfg.peering.coalesce_max_bytes = cli_opts["peer_coalesce_bytes"].as<uint32_t>();
+
+        SPDLOG_LOGGER_INFO(cfg.logger_,
+                           "Enabling peer stream data coalescing window: {} us max bytes: {}",
+                           cfg.peering.coalesce_window_us,
+                           cfg.peering.coalesce_max_bytes);
+    }
+
+    if (cli_opts.count("peer_multipath")) {
+        cfg.peering.multipath_max_paths = cli_opts["peer_multipath"].as<uint32_t>();
+        cfg.peering.multipath_srtt_margin_us = cli_opts["peer_multipath_srtt_us"].as<uint32_t>();
+
+        SPDLOG_LOGGER_INFO(cfg.logger_,
+                           "Enabling peer multipath max paths: {} srtt margin: {} us",
+                           cfg.peering.multipath_max_paths,
+                           cfg.peering.multipath_srtt_margin_us);
+    }
+
+    cfg.peering.reconnect_min_ms = cli_opts["peer_reconnect_min_ms"].as<uint32_t>();
+    cfg.peering.reconnect_max_ms =
+      std::max(cfg.peering.reconnect_min_ms, cli_opts["peer_reconnect_max_ms"].as<uint32_t>());
+
+    if (cli_opts.count("peer_unsub_holddown_ms")) {
+        cfg.peering.unsubscribe_holddown_ms = cli_opts["peer_unsub_holddown_ms"].as<uint32_t>();
+
+        SPDLOG_LOGGER_INFO(
+          cfg.logger_, "Enabling peer unsubscribe hold-down: {} ms", cfg.peering.unsubscribe_holddown_ms);
+    }
+
     if (cli_opts.count("node_type")) {
         const auto& node_type = cli_opts["node_type"].as<std::string>();
 
@@ -105,6 +137,9 @@ InitConfig(cxxopts::ParseResult& cli_opts, Config& cfg)
     cfg.peering.listening_port = cli_opts["peer_port"].as<uint16_t>();
     cfg.object_ttl_ = cli_opts["object_ttl"].as<uint32_t>();
     cfg.sub_dampen_ms_ = cli_opts["sub_dampen_ms"].as<uint32_t>();
+    cfg.ranking_interval_ms = cli_opts["ranking_interval_ms"].as<uint32_t>();
+    cfg.ranking_hysteresis = cli_opts["ranking_hysteresis"].as<uint64_t>();
+    cfg.ranking_min_dwell_ms = cli_opts["ranking_min_dwell_ms"].as<uint32_t>();
 
     cfg.relay_id_ = cli_opts["endpoint_id"].as<std::string>();
 
@@ -159,6 +194,12 @@ main(int argc, char* argv[])
             "Duration of cache objects in milliseconds",
             cxxopts::value<size_t>()->default_value("60000"))
         ("cache_key", "Value of isCached extension key", cxxopts::value<std::uint64_t>())
+        ("ranking_interval_ms", "Track ranking batch interval in milliseconds, zero updates on object receive",
+            cxxopts::value<uint32_t>()->default_value(std::to_string(kDefaultRankingIntervalMs)))
+        ("ranking_hysteresis", "Value margin a track must exceed a selected top-n track by to replace it",
+            cxxopts::value<uint64_t>()->default_value("0"))
+        ("ranking_min_dwell_ms", "Minimum time in milliseconds a top-n track stays selected",
+            cxxopts::value<uint32_t>()->default_value("0"))
         ("l,detached_subs", "Enable support for detached subscribers")
         ("disable_cache", "Disable object caching")
         ("allow_self", "Allow subscribe namespace self-subscriptions");
@@ -168,7 +209,21 @@ main(int argc, char* argv[])
             cxxopts::value<uint16_t>()->default_value(std::to_string(kDefaultPeerPort)))
         ("peer", "Peer array host[:port],...", cxxopts::value<std::vector<std::string>>())
         ("node_type", "Peer type as 'edge', 'via', 'stub'. Default is edge",
-            cxxopts::value<std::string>());
+            cxxopts::value<std::string>())
+        ("peer_coalesce_us", "Coalesce small peer stream data within window in microseconds. Default is disabled",
+            cxxopts::value<uint32_t>())
+        ("peer_coalesce_bytes", "Maximum bytes of coalesced peer stream data",
+            cxxopts::value<uint32_t>()->default_value(std::to_string(kDefaultPeerCoalesceMaxBytes)))
+        ("peer_multipath", "Maximum equal cost peer sessions to split tracks across per node. Default is disabled",
+            cxxopts::value<uint32_t>())
+        ("peer_multipath_srtt_us", "Sum sRTT margin in microseconds for a peer session to be equal cost",
+            cxxopts::value<uint32_t>()->default_value(std::to_string(kDefaultPeerMultipathSrttMarginUs)))
+        ("peer_reconnect_min_ms", "Initial peer reconnect backoff in milliseconds, doubled on each failed attempt",
+            cxxopts::value<uint32_t>()->default_value(std::to_string(kDefaultPeerReconnectMinMs)))
+        ("peer_reconnect_max_ms", "Maximum peer reconnect backoff in milliseconds",
+            cxxopts::value<uint32_t>()->default_value(std::to_string(kDefaultPeerReconnectMaxMs)))
+        ("peer_unsub_holddown_ms", "Delay peer subscribe withdraw in ms, canceled by resubscribe. Default is disabled",
+            cxxopts::value<uint32_t>());
 
     // clang-format on
 
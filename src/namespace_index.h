@@ -0,0 +1,195 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+#pragma once
+
+#include <quicr/hash.h>
+#include <quicr/track_name.h>
+
+#include <algorithm>
+#include <compare>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace laps {
+    /**
+     * @brief Namespace prefix index
+     *
+     * @details Indexes namespaces by the combined hash of each tuple prefix, the same technique used by the
+     *      peering info base for announces. A lookup costs the number of tuples in the lookup namespace plus
+     *      the number of matches instead of the number of namespaces indexed. Namespaces are reference
+     *      counted so that tables keyed by namespace and another value (e.g., connection handle) can add
+     *      the same namespace more than once. Matches are returned in namespace order, the same order
+     *      as iterating a map keyed by namespace.
+     */
+    class NamespaceIndex
+    {
+      public:
+        /**
+         * @brief Add namespace to the index, incrementing the reference count if it already exists
+         */
+        void Add(const quicr::TrackNamespace& name_space)
+        {
+            const auto prefix_hashes = PrefixHashes(name_space);
+            if (prefix_hashes.empty()) {
+                return;
+            }
+
+            auto [it, is_new] = namespaces_.try_emplace(prefix_hashes.back(), NamespaceEntry{ name_space, 0 });
+            if (is_new) {
+                for (const auto prefix_hash : prefix_hashes) {
+                    prefixes_[prefix_hash].emplace(prefix_hashes.back());
+                }
+            }
+
+            it->second.refs++;
+        }
+
+        /**
+         * @brief Remove namespace from the index, only removed when the reference count reaches zero
+         */
+        void Remove(const quicr::TrackNamespace& name_space)
+        {
+            const auto prefix_hashes = PrefixHashes(name_space);
+            if (prefix_hashes.empty()) {
+                return;
+            }
+
+            auto it = namespaces_.find(prefix_hashes.back());
+            if (it == namespaces_.end() || --it->second.refs > 0) {
+                return;
+            }
+
+            namespaces_.erase(it);
+
+            for (const auto prefix_hash : prefix_hashes) {
+                if (auto p_it = prefixes_.find(prefix_hash); p_it != prefixes_.end()) {
+                    p_it->second.erase(prefix_hashes.back());
+                    if (p_it->second.empty()) {
+                        prefixes_.erase(p_it);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Get indexed namespaces that start with the prefix namespace, including the same namespace
+         *
+         * @details Same as prefix.IsPrefixOf(name_space) being less or equivalent
+         */
+        std::vector<quicr::TrackNamespace> WithPrefix(const quicr::TrackNamespace& prefix) const
+        {
+            std::vector<quicr::TrackNamespace> matches;
+            AddWithPrefix(prefix, PrefixHashes(prefix), matches);
+
+            std::sort(matches.begin(), matches.end());
+            return matches;
+        }
+
+        /**
+         * @brief Get indexed namespaces that are a prefix of the namespace, including the same namespace
+         *
+         * @details Same as name_space.IsPrefixOf(namespace) being less or equivalent for each indexed namespace
+         */
+        std::vector<quicr::TrackNamespace> PrefixesOf(const quicr::TrackNamespace& name_space) const
+        {
+            std::vector<quicr::TrackNamespace> matches;
+            const auto prefix_hashes = PrefixHashes(name_space);
+            AddPrefixesOf(name_space, prefix_hashes, prefix_hashes.size(), matches);
+
+            std::sort(matches.begin(), matches.end());
+            return matches;
+        }
+
+        /**
+         * @brief Get indexed namespaces that have the same prefix as the namespace
+         *
+         * @details Same as name_space.HasSamePrefix(), which matches indexed namespaces that start with
+         *      the namespace and indexed namespaces that are a prefix of the namespace.
+         */
+        std::vector<quicr::TrackNamespace> Matching(const quicr::TrackNamespace& name_space) const
+        {
+            std::vector<quicr::TrackNamespace> matches;
+            const auto prefix_hashes = PrefixHashes(name_space);
+
+            // Same namespace is matched by both, only include shorter prefixes of the namespace here
+            AddWithPrefix(name_space, prefix_hashes, matches);
+            AddPrefixesOf(name_space, prefix_hashes, prefix_hashes.empty() ? 0 : prefix_hashes.size() - 1, matches);
+
+            std::sort(matches.begin(), matches.end());
+            return matches;
+        }
+
+        std::size_t Size() const noexcept { return namespaces_.size(); }
+
+      private:
+        void AddWithPrefix(const quicr::TrackNamespace& prefix,
+                           const std::vector<uint64_t>& prefix_hashes,
+                           std::vector<quicr::TrackNamespace>& matches) const
+        {
+            if (prefix_hashes.empty()) {
+                return;
+            }
+
+            auto p_it = prefixes_.find(prefix_hashes.back());
+            if (p_it == prefixes_.end()) {
+                return;
+            }
+
+            for (const auto ns_hash : p_it->second) {
+                const auto& name_space = namespaces_.at(ns_hash).name_space;
+
+                // Verify match in case of hash collision
+                const auto prefix_match = prefix.IsPrefixOf(name_space);
+                if (prefix_match == std::partial_ordering::less || prefix_match == std::partial_ordering::equivalent) {
+                    matches.push_back(name_space);
+                }
+            }
+        }
+
+        void AddPrefixesOf(const quicr::TrackNamespace& name_space,
+                           const std::vector<uint64_t>& prefix_hashes,
+                           std::size_t num_prefixes,
+                           std::vector<quicr::TrackNamespace>& matches) const
+        {
+            for (std::size_t i = 0; i < num_prefixes; ++i) {
+                auto it = namespaces_.find(prefix_hashes[i]);
+                if (it == namespaces_.end()) {
+                    continue;
+                }
+
+                // Verify match in case of hash collision
+                const auto prefix_match = it->second.name_space.IsPrefixOf(name_space);
+                if (prefix_match == std::partial_ordering::less || prefix_match == std::partial_ordering::equivalent) {
+                    matches.push_back(it->second.name_space);
+                }
+            }
+        }
+
+        static std::vector<uint64_t> PrefixHashes(const quicr::TrackNamespace& name_space)
+        {
+            const auto& entries = name_space.GetHashes();
+            std::vector<uint64_t> hashes(entries.size());
+
+            uint64_t hash = 0;
+            for (std::size_t i = 0; i < hashes.size(); ++i) {
+                quicr::hash_combine(hash, entries[i]);
+                hashes[i] = hash;
+            }
+
+            return hashes;
+        }
+
+        struct NamespaceEntry
+        {
+            quicr::TrackNamespace name_space;
+            std::size_t refs{ 0 }; ///< Number of times the namespace was added
+        };
+
+        /// Indexed namespaces by the hash of all tuples
+        std::unordered_map<uint64_t, NamespaceEntry> namespaces_;
+
+        /// Tuple prefix hash to the set of namespace hashes that start with the prefix
+        std::unordered_map<uint64_t, std::set<uint64_t>> prefixes_;
+    };
+}
@@ -5,7 +5,9 @@
 
 #include <quicr/detail/uintvar.h>
 
+#include <atomic>
 #include <iostream>
+#include <memory>
 #include <quicr/track_name.h>
 
 namespace laps::peering {
@@ -16,12 +18,18 @@ namespace laps::peering {
 #endif
 
     constexpr int kViaRelayMax = 5; ///< Maximum number of best via relays to advertise
-    constexpr uint8_t kProtocolVersion = 1;
+    constexpr uint8_t kProtocolVersion = 5;            ///< Protocol version of this relay
+    constexpr uint8_t kProtocolVersionMin = 1;         ///< Minimum protocol version accepted from peers
+    constexpr uint8_t kProtocolVersionCompactData = 2; ///< Minimum protocol version for compact data headers
+    constexpr uint8_t kProtocolVersionBulkSync = 3;    ///< Minimum protocol version for bulk sync messages
+    constexpr uint8_t kProtocolVersionSyncResume = 4;  ///< Minimum protocol version for resumable (delta) sync
+    constexpr uint8_t kProtocolVersionNodeLoad = 5;    ///< Minimum protocol version for node info load attributes
 
     using HashType = uint64_t; ///< Value data type for hashes
     using NamespaceTuples = std::vector<HashType>;
     using PeerSessionId = uint64_t;
     using SubscribeNodeSetId = uint32_t;
+    using PeerFibVersion = std::shared_ptr<const std::atomic<uint64_t>>; ///< Version of an ingress SNS peer FIB entry
 
     /**
      * @brief Peering Mode that the peer operates in to exchange info and/or data
@@ -50,7 +58,11 @@ namespace laps::peering {
         kAnnounceInfoAdvertised,
         kAnnounceInfoWithdrawn,
         kSubscribeNodeSetAdvertised,
-        kSubscribeNodeSetWithdrawn
+        kSubscribeNodeSetWithdrawn,
+
+        kBulkSync,
+        kSyncRequest,
+        kSyncState
     };
 
     constexpr uint16_t kCommonHeadersSize = 7; ///< Size of the headers in bytes
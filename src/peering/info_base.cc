@@ -3,30 +3,129 @@
 
 #include "info_base.h"
 #include <quicr/hash.h>
+#include <random>
 
 namespace laps::peering {
-    bool InfoBase::AddNode(std::shared_ptr<PeerSession> peer_session, const NodeInfo& node_info)
+    std::vector<InfoBase::BestPathChange> InfoBase::AddNode(std::shared_ptr<PeerSession> peer_session,
+                                                            const NodeInfo& node_info)
     {
         std::lock_guard _(mutex_);
 
-        auto it = nodes_.find({ node_info.id, peer_session->GetSessionId() });
+        std::vector<BestPathChange> changes;
+
+        const auto peer_session_id = peer_session->GetSessionId();
+
+        // Node info from the direct peer updates the next hop load of all paths via the peer session
+        bool next_hop_changed{ false };
+        if (node_info.path.empty()) {
+            auto [nh_it, is_new] = next_hops_.try_emplace(peer_session_id, NextHop{ node_info.id, node_info.load });
+            if (!is_new && !(nh_it->second.node_id == node_info.id && nh_it->second.load == node_info.load)) {
+                nh_it->second = { node_info.id, node_info.load };
+                next_hop_changed = true;
+            }
+        }
+
+        bool topology_changed{ true };
+
+        auto it = nodes_.find({ node_info.id, peer_session_id });
         if (it == nodes_.end()) {
             // New node entry
-            nodes_.try_emplace({ node_info.id, peer_session->GetSessionId() }, NodeItem{ peer_session, node_info });
+            nodes_.try_emplace({ node_info.id, peer_session_id }, NodeItem{ peer_session, node_info });
         } else {
             // Existing update
+            topology_changed = IsTopologyChange(it->second.node_info, node_info);
             it->second = { peer_session, node_info };
         }
 
-        nodes_by_peer_session_[peer_session->GetSessionId()].emplace(node_info.id);
+        SetPathCandidate(node_info.id, peer_session_id, &node_info);
+
+        auto& node_ids = nodes_by_peer_session_[peer_session_id];
+        node_ids.emplace(node_info.id);
 
-        return SelectBestNode(node_info.id);
+        // Periodic load and sRTT refreshes are not logged, peers get them with the next refresh
+        if (topology_changed) {
+            nodes_sync_log_.Add(node_info, false);
+        }
+
+        if (next_hop_changed) {
+            for (const auto node_id : node_ids) {
+                if (node_id == node_info.id) {
+                    continue;
+                }
+
+                SetPathCandidate(node_id, peer_session_id, &nodes_.at({ node_id, peer_session_id }).node_info);
+                SelectBestNode(node_id, changes);
+            }
+        }
+
+        SelectBestNode(node_info.id, changes);
+        return changes;
+    }
+
+    bool InfoBase::IsTopologyChange(const NodeInfo& current, const NodeInfo& update)
+    {
+        return current.type != update.type || current.contact != update.contact ||
+               current.longitude != update.longitude || current.latitude != update.latitude ||
+               !std::ranges::equal(current.path, update.path, [](const NodePathItem& a, const NodePathItem& b) {
+                   return a.id == b.id;
+               });
+    }
+
+    InfoBase::PathCandidate InfoBase::MakePathCandidate(NodeIdValueType node_id,
+                                                        PeerSessionId peer_session_id,
+                                                        const NodeInfo& node_info) const
+    {
+        PathCandidate path{ false, node_info.path.size(), node_info.SumSrtt(), peer_session_id };
+
+        // Weight by the load of the next hop via relay, the load of the node itself is the same for all paths
+        if (auto it = next_hops_.find(peer_session_id); it != next_hops_.end() && it->second.node_id != node_id) {
+            path.overloaded = it->second.load.Overloaded();
+            path.weighted_srtt += path.weighted_srtt * it->second.load.cpu_pct / 100;
+        }
+
+        return path;
     }
 
-    void InfoBase::RemoveNode(PeerSessionId peer_session_id, NodeIdValueType node_id)
+    void InfoBase::SetPathCandidate(NodeIdValueType node_id, PeerSessionId peer_session_id, const NodeInfo* node_info)
+    {
+        auto& paths = node_paths_[node_id];
+
+        if (auto it = node_path_keys_.find({ node_id, peer_session_id }); it != node_path_keys_.end()) {
+            paths.erase(it->second);
+            node_path_keys_.erase(it);
+        }
+
+        if (node_info != nullptr) {
+            const auto path = MakePathCandidate(node_id, peer_session_id, *node_info);
+            paths.emplace(path);
+            node_path_keys_.emplace(std::make_pair(node_id, peer_session_id), path);
+        }
+
+        if (paths.empty()) {
+            node_paths_.erase(node_id);
+        }
+    }
+
+    void InfoBase::EraseNode(decltype(nodes_)::iterator it)
+    {
+        const auto& [key, node_item] = *it;
+
+        SetPathCandidate(key.first, key.second, nullptr);
+
+        if (node_item.node_info.path.empty()) {
+            next_hops_.erase(key.second);
+        }
+
+        nodes_sync_log_.Add(node_item.node_info, true);
+        nodes_.erase(it);
+    }
+
+    std::vector<InfoBase::BestPathChange> InfoBase::RemoveNode(PeerSessionId peer_session_id, NodeIdValueType node_id)
     {
         std::lock_guard _(mutex_);
 
+        std::vector<BestPathChange> changes;
+
         auto ids_it = nodes_by_peer_session_.find(peer_session_id);
         if (ids_it != nodes_by_peer_session_.end()) {
             ids_it->second.erase(node_id);
@@ -36,29 +135,28 @@ namespace laps::peering {
             }
         }
 
-        nodes_.erase({ node_id, peer_session_id });
-
-        if (nodes_best_.erase(node_id) > 0) {
-            SelectBestNode(node_id);
-            // TODO(tievens): Update subscribes and announces based on best change
+        if (auto it = nodes_.find({ node_id, peer_session_id }); it != nodes_.end()) {
+            EraseNode(it);
         }
+
+        SelectBestNode(node_id, changes);
+        return changes;
     }
 
-    void InfoBase::PurgePeerSessionInfo(PeerSessionId peer_session_id)
+    std::vector<InfoBase::BestPathChange> InfoBase::PurgePeerSessionInfo(PeerSessionId peer_session_id)
     {
-        std::vector<NodeIdValueType> node_ids;
-        node_ids.reserve(10);
-
         std::lock_guard _(mutex_);
 
+        std::vector<BestPathChange> changes;
+
         auto ids_it = nodes_by_peer_session_.find(peer_session_id);
         if (ids_it != nodes_by_peer_session_.end()) {
             for (const auto& node_id : ids_it->second) {
-                nodes_.erase({ node_id, peer_session_id });
-
-                if (nodes_best_.erase(node_id) > 0) {
-                    SelectBestNode(node_id);
+                if (auto it = nodes_.find({ node_id, peer_session_id }); it != nodes_.end()) {
+                    EraseNode(it);
                 }
+
+                SelectBestNode(node_id, changes);
             }
 
             nodes_by_peer_session_.erase(ids_it);
@@ -78,6 +176,44 @@ namespace laps::peering {
         for (const auto& key : fib_entries) {
             peer_fib_.erase(key);
         }
+
+        // Streams of the purged peer session may still hold the versions, change them before removing
+        std::lock_guard version_lock(peer_fib_versions_mutex_);
+        for (auto it = peer_fib_versions_.lower_bound({ peer_session_id, 0 });
+             it != peer_fib_versions_.end() && it->first.first == peer_session_id;) {
+            (*it->second)++;
+            it = peer_fib_versions_.erase(it);
+        }
+
+        return changes;
+    }
+
+    PeerFibVersion InfoBase::GetPeerFibVersion(PeerSessionId peer_session_id, SubscribeNodeSetId sns_id)
+    {
+        std::lock_guard _(peer_fib_versions_mutex_);
+
+        auto [it, is_new] = peer_fib_versions_.try_emplace({ peer_session_id, sns_id });
+        if (is_new) {
+            it->second = std::make_shared<std::atomic<uint64_t>>(0);
+        }
+
+        return it->second;
+    }
+
+    void InfoBase::PeerFibChanged(PeerSessionId peer_session_id, SubscribeNodeSetId sns_id, bool removed)
+    {
+        std::lock_guard _(peer_fib_versions_mutex_);
+
+        auto it = peer_fib_versions_.find({ peer_session_id, sns_id });
+        if (it == peer_fib_versions_.end()) {
+            return; // No stream is using the version
+        }
+
+        (*it->second)++;
+
+        if (removed) {
+            peer_fib_versions_.erase(it);
+        }
     }
 
     bool InfoBase::HasSubscribers(const SubscribeInfo& subscribe_info)
@@ -107,14 +243,56 @@ namespace laps::peering {
             }
 
             it->second = subscribe_info;
+            subscribes_sync_log_.Add(subscribe_info, false);
             return true;
         }
 
         subscribes_[subscribe_info.track_hash.track_fullname_hash].emplace(subscribe_info.source_node_id,
                                                                            subscribe_info);
+        subscribes_by_node_[subscribe_info.source_node_id].emplace(subscribe_info.track_hash.track_fullname_hash);
+        subscribes_sync_log_.Add(subscribe_info, false);
+        IndexSubscribe(subscribe_info, false);
         return true;
     }
 
+    void InfoBase::IndexSubscribe(const SubscribeInfo& subscribe_info, bool remove)
+    {
+        std::vector<std::size_t> prefix_hashes;
+
+        try {
+            prefix_hashes = PrefixHashNamespaceTuples(subscribe_info.View().track_namespace);
+        } catch (const std::exception&) {
+            // Subscribe data that cannot be decoded is not matched by announces
+            return;
+        }
+
+        if (prefix_hashes.empty()) {
+            return;
+        }
+
+        const auto fullname_hash = subscribe_info.track_hash.track_fullname_hash;
+
+        const auto update = [&](auto& lookup, std::size_t prefix_hash) {
+            if (not remove) {
+                lookup[prefix_hash].emplace(fullname_hash);
+                return;
+            }
+
+            if (auto it = lookup.find(prefix_hash); it != lookup.end()) {
+                it->second.erase(fullname_hash);
+                if (it->second.empty()) {
+                    lookup.erase(it);
+                }
+            }
+        };
+
+        for (const auto& prefix_hash : prefix_hashes) {
+            update(prefix_lookup_subscribes_, prefix_hash);
+        }
+
+        update(namespace_lookup_subscribes_, prefix_hashes.back());
+    }
+
     bool InfoBase::RemoveSubscribe(const SubscribeInfo& subscribe_info)
     {
         std::lock_guard _(mutex_);
@@ -124,6 +302,20 @@ namespace laps::peering {
             auto sub_it = it->second.find(subscribe_info.source_node_id);
             if (sub_it != it->second.end()) {
                 // TODO(tievens): Revisit to check on order of received or delayed messages
+                subscribes_sync_log_.Add(sub_it->second, true);
+
+                if (it->second.size() == 1) {
+                    IndexSubscribe(sub_it->second, true);
+                }
+
+                if (auto node_it = subscribes_by_node_.find(subscribe_info.source_node_id);
+                    node_it != subscribes_by_node_.end()) {
+                    node_it->second.erase(it->first);
+                    if (node_it->second.empty()) {
+                        subscribes_by_node_.erase(node_it);
+                    }
+                }
+
                 it->second.erase(sub_it);
 
                 if (it->second.empty()) {
@@ -171,6 +363,8 @@ namespace laps::peering {
           announces_[announce_info.fullname_hash].emplace(announce_info.source_node_id, announce_info);
 
         if (is_new) {
+            announces_sync_log_.Add(announce_info, false);
+
             for (const auto& prefix_hash : PrefixHashNamespaceTuples(announce_info.name_space)) {
                 auto it = prefix_lookup_announces_.find(prefix_hash);
                 if (it == prefix_lookup_announces_.end()) {
@@ -220,7 +414,10 @@ namespace laps::peering {
                 prefix_lookup_announces_.erase(prefix_hash);
             }
 
-            anno_it->second.erase(announce_info.source_node_id);
+            if (auto src_it = anno_it->second.find(announce_info.source_node_id); src_it != anno_it->second.end()) {
+                announces_sync_log_.Add(src_it->second, true);
+                anno_it->second.erase(src_it);
+            }
 
             if (anno_it->second.empty()) {
                 announces_.erase(anno_it);
@@ -230,6 +427,28 @@ namespace laps::peering {
         return removed;
     }
 
+    void InfoBase::ClearAnnounces()
+    {
+        std::lock_guard _(mutex_);
+
+        announces_.clear();
+        prefix_lookup_announces_.clear();
+        announces_sync_log_.Reset();
+    }
+
+    uint64_t InfoBase::NewSyncEpoch()
+    {
+        std::random_device rd;
+        std::mt19937_64 gen(rd());
+
+        uint64_t epoch{ 0 };
+        while (epoch == 0) {
+            epoch = gen();
+        }
+
+        return epoch;
+    }
+
     std::set<NodeIdValueType> InfoBase::GetAnnounceIds(quicr::TrackNamespace name_space,
                                                        quicr::messages::TrackName name,
                                                        bool exact)
@@ -267,6 +486,64 @@ namespace laps::peering {
         return announces_ids;
     }
 
+    std::vector<SubscribeInfo> InfoBase::GetPrefixMatchingSubscribes(const quicr::TrackNamespace& name_space)
+    {
+        std::vector<SubscribeInfo> subscribes;
+        std::lock_guard _(mutex_);
+
+        const auto prefix_hashes = PrefixHashNamespaceTuples(name_space);
+        if (prefix_hashes.empty()) {
+            return subscribes;
+        }
+
+        std::set<quicr::TrackFullNameHash> fullname_hashes;
+
+        // Subscribes that have the namespace as a prefix, including the same namespace
+        if (auto it = prefix_lookup_subscribes_.find(prefix_hashes.back()); it != prefix_lookup_subscribes_.end()) {
+            fullname_hashes.insert(it->second.begin(), it->second.end());
+        }
+
+        // Subscribes that are a shorter prefix of the namespace
+        for (std::size_t i = 0; i + 1 < prefix_hashes.size(); ++i) {
+            if (auto it = namespace_lookup_subscribes_.find(prefix_hashes[i]);
+                it != namespace_lookup_subscribes_.end()) {
+                fullname_hashes.insert(it->second.begin(), it->second.end());
+            }
+        }
+
+        for (const auto fullname_hash : fullname_hashes) {
+            if (auto it = subscribes_.find(fullname_hash); it != subscribes_.end()) {
+                for (const auto& si : it->second) {
+                    subscribes.push_back(si.second);
+                }
+            }
+        }
+
+        return subscribes;
+    }
+
+    std::vector<SubscribeInfo> InfoBase::GetSubscribesBySourceNode(NodeIdValueType node_id)
+    {
+        std::lock_guard _(mutex_);
+
+        std::vector<SubscribeInfo> subscribes;
+
+        auto node_it = subscribes_by_node_.find(node_id);
+        if (node_it == subscribes_by_node_.end()) {
+            return subscribes;
+        }
+
+        for (const auto fullname_hash : node_it->second) {
+            if (auto it = subscribes_.find(fullname_hash); it != subscribes_.end()) {
+                if (auto sub_it = it->second.find(node_id); sub_it != it->second.end()) {
+                    subscribes.push_back(sub_it->second);
+                }
+            }
+        }
+
+        return subscribes;
+    }
+
     std::weak_ptr<PeerSession> InfoBase::GetBestPeerSession(NodeIdValueType node_id)
     {
         std::lock_guard _(mutex_);
@@ -278,72 +555,200 @@ namespace laps::peering {
         return {};
     }
 
-    bool InfoBase::SelectBestNode(NodeIdValueType node_id)
+    std::weak_ptr<PeerSession> InfoBase::GetPeerSessionForFlow(NodeIdValueType node_id, uint64_t flow_hash)
+    {
+        std::lock_guard _(mutex_);
+
+        auto mp_it = nodes_multipath_.find(node_id);
+        if (mp_it != nodes_multipath_.end()) {
+            // Rendezvous hashing; highest weight of flow and peer session wins
+            std::size_t best_weight{ 0 };
+            const std::weak_ptr<PeerSession>* selected{ nullptr };
+
+            for (const auto& [peer_session_id, peer_session] : mp_it->second) {
+                std::size_t weight = flow_hash;
+                quicr::hash_combine(weight, peer_session_id);
+
+                if (selected == nullptr || weight > best_weight) {
+                    best_weight = weight;
+                    selected = &peer_session;
+                }
+            }
+
+            if (selected != nullptr) {
+                return *selected;
+            }
+        }
+
+        auto it = nodes_best_.find(node_id);
+        if (it != nodes_best_.end()) {
+            return it->second;
+        }
+        return {};
+    }
+
+    void InfoBase::SetMultipath(std::size_t max_paths, uint64_t srtt_margin_us)
     {
-        bool is_updated{ false };
+        std::lock_guard _(mutex_);
 
-        std::weak_ptr<PeerSession> best_peer_session;
+        multipath_max_paths_ = max_paths ? max_paths : 1;
+        multipath_srtt_margin_us_ = srtt_margin_us;
+    }
 
-        NodeInfo best_node_info;
-        auto best_it = nodes_best_.find(node_id);
-        if (best_it != nodes_best_.end()) {
-            best_peer_session = best_it->second;
-            best_node_info = nodes_.at({ node_id, best_peer_session.lock()->GetSessionId() }).node_info;
+    bool InfoBase::UpdateMultipath(NodeIdValueType node_id)
+    {
+        if (multipath_max_paths_ <= 1) {
+            return false;
         }
 
-        for (auto it = nodes_.lower_bound({ node_id, 0 }); it != nodes_.end(); it++) {
-            auto& [key, node_item] = *it;
+        // Ids of the equal cost peer sessions, a node without multipath has none
+        const auto path_ids = [this](NodeIdValueType id) {
+            std::set<PeerSessionId> ids;
+            if (const auto it = nodes_multipath_.find(id); it != nodes_multipath_.end()) {
+                for (const auto& [peer_session_id, _] : it->second) {
+                    ids.insert(peer_session_id);
+                }
+            }
+            return ids;
+        };
+
+        const auto prev_path_ids = path_ids(node_id);
+
+        const auto best_id_it = nodes_best_id_.find(node_id);
+        const auto paths_it = node_paths_.find(node_id);
+        if (best_id_it == nodes_best_id_.end() || paths_it == node_paths_.end()) {
+            nodes_multipath_.erase(node_id);
+            return !prev_path_ids.empty();
+        }
+
+        const auto best_session_id = best_id_it->second;
+        const auto best_peer_session = nodes_.at({ node_id, best_session_id }).peer_session.lock();
+
+        if (best_peer_session == nullptr) {
+            nodes_multipath_.erase(node_id);
+            return !prev_path_ids.empty();
+        }
 
-            if (key.first != node_id) {
+        const auto& best_path = node_path_keys_.at({ node_id, best_session_id });
+
+        std::vector<std::pair<PeerSessionId, std::weak_ptr<PeerSession>>> paths{ { best_session_id,
+                                                                                   best_peer_session } };
+
+        // Candidates are ordered by cost, stop at the first that is not equal cost
+        for (const auto& path : paths_it->second) {
+            if (paths.size() >= multipath_max_paths_) {
                 break;
             }
 
-            if (best_peer_session.lock() == nullptr) {
-                is_updated = true;
-                best_peer_session = node_item.peer_session.lock();
-                best_node_info = nodes_.at({ node_id, best_peer_session.lock()->GetSessionId() }).node_info;
+            if (path.peer_session_id == best_session_id) {
                 continue;
             }
 
-            /**
-             * Algorithm to select best peering session
-             * TODO(tievens): Add more advance selectors, such as load, geo distance, ...
-             *
-             * Choose the node that first matches the below in the order defined:
-             *
-             * 1. Prefer lower size `path` (hops)
-             * 2. Prefer lower total sRTT
-             *
-             */
-            if (best_node_info.path.size() > node_item.node_info.path.size() ||
-                best_node_info.SumSrtt() > node_item.node_info.SumSrtt()) {
-                is_updated = true;
-                best_peer_session = node_item.peer_session.lock();
-                best_node_info = nodes_.at({ node_id, best_peer_session.lock()->GetSessionId() }).node_info;
+            if (path.overloaded != best_path.overloaded || path.path_len != best_path.path_len) {
+                if (path < best_path) {
+                    continue;
+                }
+                break;
+            }
+
+            if (path.weighted_srtt > best_path.weighted_srtt + multipath_srtt_margin_us_) {
+                break;
+            }
+
+            const auto& node_item = nodes_.at({ node_id, path.peer_session_id });
+            if (!node_item.peer_session.expired()) {
+                paths.emplace_back(path.peer_session_id, node_item.peer_session);
             }
         }
 
-        if (is_updated) {
-            nodes_best_[node_id] = best_peer_session;
+        if (paths.size() > 1) {
+            nodes_multipath_[node_id] = std::move(paths);
+        } else {
+            nodes_multipath_.erase(node_id);
+        }
+
+        return path_ids(node_id) != prev_path_ids;
+    }
+
+    bool InfoBase::SelectBestNode(NodeIdValueType node_id, std::vector<BestPathChange>& changes)
+    {
+        std::optional<PeerSessionId> prev_best_id;
+        if (auto it = nodes_best_id_.find(node_id); it != nodes_best_id_.end()) {
+            prev_best_id = it->second;
+        }
+
+        /**
+         * Algorithm to select best peering session
+         * TODO(tievens): Add more advance selectors, such as geo distance, ...
+         *
+         * Choose the node that first matches the below in the order defined:
+         *
+         * 1. Prefer next hop via relay that is not overloaded
+         * 2. Prefer lower size `path` (hops)
+         * 3. Prefer lower total sRTT, weighted by the CPU load of the next hop via relay
+         *
+         * Candidates are ordered by the above. The current best is kept if it's equal to the first candidate.
+         */
+        const PathCandidate* best_path{ nullptr };
+        if (auto paths_it = node_paths_.find(node_id); paths_it != node_paths_.end()) {
+            for (const auto& path : paths_it->second) {
+                if (nodes_.at({ node_id, path.peer_session_id }).peer_session.expired()) {
+                    continue;
+                }
+
+                if (best_path == nullptr) {
+                    best_path = &path;
+                }
+
+                if (!prev_best_id.has_value() || path.overloaded != best_path->overloaded ||
+                    path.path_len != best_path->path_len || path.weighted_srtt != best_path->weighted_srtt) {
+                    break;
+                }
+
+                if (path.peer_session_id == *prev_best_id) {
+                    best_path = &path;
+                    break;
+                }
+            }
+        }
+
+        std::optional<PeerSessionId> best_id;
+        if (best_path != nullptr) {
+            best_id = best_path->peer_session_id;
+            nodes_best_[node_id] = nodes_.at({ node_id, *best_id }).peer_session;
+            nodes_best_id_[node_id] = *best_id;
+        } else {
+            nodes_best_.erase(node_id);
+            nodes_best_id_.erase(node_id);
+        }
+
+        const bool is_updated = best_id != prev_best_id;
 
-            SPDLOG_DEBUG("Forwarding Table Dump BEGIN ------------------------------");
+        // Equal cost peer sessions may change even if the best did not
+        const bool multipath_updated = UpdateMultipath(node_id);
 
-            // DEBUG - Dump the best nodes and their peering sessions to reach them
-            for (const auto& node : nodes_best_) {
-                auto node_info = node.second.lock();
-                auto node_item = nodes_.at({ node.first, node_info->GetSessionId() });
-                SPDLOG_DEBUG("Forwarding table node id: {} contact {} best via peer_session id: {} contact: {} "
-                             "path_len: {} sum_srtt: {}",
-                             NodeId().Value(node.first),
+        if (is_updated || multipath_updated) {
+            changes.push_back({ node_id, prev_best_id, best_id });
+        }
+
+        if (is_updated) {
+            if (best_path != nullptr) {
+                const auto& node_item = nodes_.at({ node_id, *best_id });
+                SPDLOG_DEBUG("Forwarding table node id: {} contact {} best via peer_session id: {} "
+                             "path_len: {} sum_srtt: {} weighted_srtt: {} overloaded: {}",
+                             NodeId().Value(node_id),
                              node_item.node_info.contact,
-                             node_info->GetSessionId(),
-                             node_info->remote_node_info_.contact,
-                             node_item.node_info.path.size(),
-                             node_item.node_info.SumSrtt());
+                             *best_id,
+                             best_path->path_len,
+                             node_item.node_info.SumSrtt(),
+                             best_path->weighted_srtt,
+                             best_path->overloaded);
+            } else {
+                SPDLOG_DEBUG("Forwarding table node id: {} removed, no peer session to reach it",
+                             NodeId().Value(node_id));
             }
-            SPDLOG_DEBUG("Forwarding Table Dump DONE ------------------------------");
         }
 
-        return is_updated;
+        return is_updated && best_id.has_value();
     }
 }
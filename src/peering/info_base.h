@@ -7,12 +7,20 @@
 #include "peer_session.h"
 #include "peering/messages/subscribe_info.h"
 
+#include <algorithm>
+#include <atomic>
+#include <compare>
+#include <deque>
 #include <map>
+#include <optional>
 #include <quicr/detail/messages.h>
+#include <quicr/hash.h>
 #include <set>
 
 namespace laps::peering {
 
+    constexpr std::size_t kSyncLogMaxChanges = 100'000; ///< Maximum changes per table kept to resume peer sync
+
     /**
      * @brief Forwarding information base
      * @details Computed subscribe and announcements are added and maintained
@@ -23,24 +31,70 @@ namespace laps::peering {
         InfoBase() = default;
         virtual ~InfoBase() = default;
 
+        /**
+         * @brief Change of the peer sessions to reach a node
+         * @details Either the best peer session or the equal cost (multipath) peer sessions of the node changed.
+         *      The previous and new best are the same when only the equal cost peer sessions changed.
+         */
+        struct BestPathChange
+        {
+            NodeIdValueType node_id{ 0 };
+            std::optional<PeerSessionId> prev_peer_session_id; ///< Previous best, nullopt if the node was new
+            std::optional<PeerSessionId> peer_session_id;      ///< New best, nullopt if the node is unreachable
+
+            bool BestChanged() const { return prev_peer_session_id != peer_session_id; }
+        };
+
         /**
          * @brief Add or update node in the info base
          * @details This will add or update a node in the info base. Upon update, other tables
          *   will be updated to compute the best node based on change.
          *
-         * @returns True if the node is updated as best
+         * @returns Best path changes caused by the update, in the order they happened. Only the SNS and
+         *   FIB entries of the changed nodes need to be evaluated instead of all of them.
          */
-        bool AddNode(std::shared_ptr<PeerSession> peer_session, const NodeInfo& node_info);
+        std::vector<BestPathChange> AddNode(std::shared_ptr<PeerSession> peer_session, const NodeInfo& node_info);
 
         /**
          * @brief Remove node from the info base
+         *
+         * @returns Best path changes caused by the removal
          */
-        void RemoveNode(PeerSessionId peer_session_id, NodeIdValueType node_id);
+        std::vector<BestPathChange> RemoveNode(PeerSessionId peer_session_id, NodeIdValueType node_id);
+
+        /**
+         * @brief Check if a node info update changes the topology
+         * @details Topology changes are changes of the node attributes or the path of nodes. Changes of only
+         *      the load or the path sRTT values are periodic refreshes and are not topology changes.
+         */
+        static bool IsTopologyChange(const NodeInfo& current, const NodeInfo& update);
 
         /**
          * @brief Purge peer session information
+         *
+         * @returns Best path changes of the nodes that were reached via the peer session
+         */
+        std::vector<BestPathChange> PurgePeerSessionInfo(PeerSessionId peer_session_id);
+
+        /**
+         * @brief Get the version of the peer FIB entry of an ingress SNS
+         * @details Version is incremented whenever the egress entries of the ingress SNS are added, updated
+         *   or removed. Cut-through streams keep the version and compare it per chunk to detect that the
+         *   egress list needs to be resolved again. Changes of other SNS do not change the version.
+         *
+         * @param peer_session_id       Ingress peer session id
+         * @param sns_id                Ingress SNS id
+         */
+        PeerFibVersion GetPeerFibVersion(PeerSessionId peer_session_id, SubscribeNodeSetId sns_id);
+
+        /**
+         * @brief Increment the version of the peer FIB entry of an ingress SNS
+         *
+         * @param peer_session_id       Ingress peer session id
+         * @param sns_id                Ingress SNS id
+         * @param removed               True if the peer FIB entry was removed, the version is no longer tracked
          */
-        void PurgePeerSessionInfo(PeerSessionId peer_session_id);
+        void PeerFibChanged(PeerSessionId peer_session_id, SubscribeNodeSetId sns_id, bool removed = false);
 
         /**
          * @brief Add or update subscribe in the info base
@@ -90,6 +144,12 @@ namespace laps::peering {
          */
         bool RemoveAnnounce(const AnnounceInfo& announce_info);
 
+        /**
+         * @brief Remove all announces from the info base
+         * @details Peers cannot resume announce sync from before the announces were cleared
+         */
+        void ClearAnnounces();
+
         /**
          * @brief Get matching (prefix matched) announce source node Ids
          *
@@ -110,19 +170,69 @@ namespace laps::peering {
                                                  quicr::messages::TrackName name,
                                                  bool exact);
 
+        /**
+         * @brief Get subscribes that prefix match the namespace
+         *
+         * @details Returns subscribes where either the subscribe namespace is a prefix of the namespace
+         *      or the namespace is a prefix of the subscribe namespace. This is the same match as
+         *      TrackNamespace::HasSamePrefix(). Lookup is done using the prefix hash tables, which
+         *      is the number of namespace tuples plus the number of matches.
+         *
+         * @param name_space        Namespace to match subscribes
+         *
+         * @returns a copy of the matching subscribes
+         */
+        std::vector<SubscribeInfo> GetPrefixMatchingSubscribes(const quicr::TrackNamespace& name_space);
+
+        /**
+         * @brief Get subscribes from a source node
+         *
+         * @param node_id           Source node id of the subscribes
+         *
+         * @returns a copy of the subscribes from the source node
+         */
+        std::vector<SubscribeInfo> GetSubscribesBySourceNode(NodeIdValueType node_id);
+
         /**
          * @brief Gets the best peer session for given node id
          */
         std::weak_ptr<PeerSession> GetBestPeerSession(NodeIdValueType node_id);
 
+        /**
+         * @brief Gets the peer session to use for a flow to the given node id
+         * @details When multipath is enabled and the node has more than one equal cost peer session,
+         *   the flow hash is used to select one of them. Selection uses rendezvous hashing, which
+         *   moves only the flows of a removed peer session and about 1/n of the flows when an equal
+         *   cost peer session is added.
+         *
+         * @param node_id           Node id to reach
+         * @param flow_hash         Flow hash, such as the track full name hash
+         *
+         * @return Peer session to use for the flow, empty if the node is not reachable
+         */
+        std::weak_ptr<PeerSession> GetPeerSessionForFlow(NodeIdValueType node_id, uint64_t flow_hash);
+
+        /**
+         * @brief Set multipath (equal cost) peer session selection
+         *
+         * @param max_paths         Maximum number of peer sessions per node, 1 disables multipath
+         * @param srtt_margin_us    Sum sRTT margin in microseconds from the best to be considered equal cost
+         */
+        void SetMultipath(std::size_t max_paths, uint64_t srtt_margin_us);
+
         /**
          * @brief Selects and updates the best peer session to use for given node id
          * @details Implements the selection algorithm to find the best peering session
-         *   to reach the node.
+         *   to reach the node. Candidate paths are kept ordered per node, so selection takes the first
+         *   candidate instead of scanning all nodes. Candidates via an overloaded or loaded next hop
+         *   relay are less preferred.
+         *
+         * @param node_id           Node id to select the best peer session for
+         * @param changes           A change of the best or equal cost peer sessions is appended to the changes
          *
          * @return True if node is better and updated, False if not
          */
-        bool SelectBestNode(NodeIdValueType node_id);
+        bool SelectBestNode(NodeIdValueType node_id, std::vector<BestPathChange>& changes);
 
         struct NodeItem
         {
@@ -146,8 +256,51 @@ namespace laps::peering {
          */
         std::unordered_map<NodeIdValueType, std::weak_ptr<PeerSession>> nodes_best_;
 
+        /**
+         * @brief Equal cost peer sessions for node id
+         * @details Indexed by node id. Peer sessions that have the same path length as the best and a
+         *    sum sRTT within the multipath sRTT margin of the best. Only nodes that have more than one equal
+         *    cost peer session are in this map. It is updated whenever nodes_best_ is updated.
+         */
+        std::unordered_map<NodeIdValueType, std::vector<std::pair<PeerSessionId, std::weak_ptr<PeerSession>>>>
+          nodes_multipath_;
+
         std::map<quicr::TrackFullNameHash, std::map<NodeIdValueType, SubscribeInfo>> subscribes_;
 
+        /**
+         * @brief Subscribe track full name hashes by source node id
+         * @details This map is updated whenever subscribes_ is updated. It's used to find the subscribes
+         *   affected by a best path change of the source node.
+         */
+        std::map<NodeIdValueType, std::set<quicr::TrackFullNameHash>> subscribes_by_node_;
+
+        /**
+         * @brief Client stream key
+         * @details Client published objects are not received via a peer stream, so the ingress stream
+         *   is identified by the client connection, group and subgroup of the published track. Group and
+         *   subgroup are kept in full to avoid aliasing of large group or subgroup ids. The connection
+         *   handle keeps publishers of the same track from sharing or closing each other's streams.
+         */
+        struct ClientStreamKey
+        {
+            uint64_t connection_handle{ 0 };
+            uint64_t group_id{ 0 };
+            uint64_t subgroup_id{ 0 };
+
+            bool operator==(const ClientStreamKey&) const = default;
+        };
+
+        struct ClientStreamKeyHash
+        {
+            std::size_t operator()(const ClientStreamKey& key) const noexcept
+            {
+                std::size_t hash = std::hash<uint64_t>{}(key.connection_handle);
+                quicr::hash_combine(hash, std::hash<uint64_t>{}(key.group_id));
+                quicr::hash_combine(hash, std::hash<uint64_t>{}(key.subgroup_id));
+                return hash;
+            }
+        };
+
         struct FibEntry
         {
             uint64_t update_ref{ 0 }; ///< Random reference number to detect if entry was updated or not
@@ -155,6 +308,38 @@ namespace laps::peering {
             SubscribeNodeSetId out_sns_id;                  ///< Egress SNS ID
             decltype(nodes_best_)::mapped_type peer_session;
             uint64_t track_fullname_hash{ 0 };
+
+            /// Client (connection, group, subgroup) to egress stream id. Only used by client_fib_ entries
+            std::unordered_map<ClientStreamKey, uint64_t, ClientStreamKeyHash> client_streams;
+
+            /**
+             * @brief Remove the client stream of the key
+             *
+             * @returns Egress stream id of the removed stream, or nullopt if the key has no stream
+             */
+            std::optional<uint64_t> EraseClientStream(const ClientStreamKey& key)
+            {
+                const auto it = client_streams.find(key);
+                if (it == client_streams.end()) {
+                    return std::nullopt;
+                }
+
+                const auto out_stream_id = it->second;
+                client_streams.erase(it);
+                return out_stream_id;
+            }
+
+            /**
+             * @brief Remove the client stream using the egress stream id
+             *
+             * @returns True if a client stream was removed, False if no client stream uses the stream id
+             */
+            bool EraseClientStreamById(uint64_t out_stream_id)
+            {
+                return std::erase_if(client_streams, [out_stream_id](const auto& item) {
+                           return item.second == out_stream_id;
+                       }) > 0;
+            }
         };
 
         /**
@@ -180,6 +365,7 @@ namespace laps::peering {
          */
         std::map<std::pair<PeerSessionId, SubscribeNodeSetId>, std::map<PeerSessionId, FibEntry>> peer_fib_;
 
+
         /**
          * @brief State map of announces received
          *
@@ -201,16 +387,173 @@ namespace laps::peering {
          */
         std::map<quicr::TrackNamespaceHash, std::set<quicr::TrackNamespaceHash>> prefix_lookup_announces_;
 
+        /**
+         * @brief State map of prefix matchable tuple hashes to subscribe full track name hash
+         *
+         * @details Same as prefix_lookup_announces_, but for subscribes. Each tuple prefix hash of the
+         *      subscribe namespace is mapped to the subscribe track full name hash in subscribes_.
+         */
+        std::map<quicr::TrackNamespaceHash, std::set<quicr::TrackFullNameHash>> prefix_lookup_subscribes_;
+
+        /**
+         * @brief State map of full subscribe namespace hash (last tuple prefix hash) to subscribe full track name hash
+         *
+         * @details Used to find subscribes that have a namespace that is a shorter prefix of the lookup namespace.
+         */
+        std::map<quicr::TrackNamespaceHash, std::set<quicr::TrackFullNameHash>> namespace_lookup_subscribes_;
+
         /**
          * @brief Nodes by peer session id
          * @details This map is updated whenever nodes_ is updated. It's used when cleaning up the other node tables
          *   on peer disconnect/cleanup.
          */
         std::map<PeerSessionId, std::set<NodeIdValueType>> nodes_by_peer_session_;
+
+        /**
+         * @brief Change log of an information base table
+         * @details Each add, update or remove of an entry increments the table version and records the
+         *    change. Peers that reconnect send the last version they synced, which is used to send only the
+         *    changes since that version. The log is bounded; a peer that is too far behind gets a full sync.
+         */
+        template<typename Info>
+        struct SyncLog
+        {
+            struct Change
+            {
+                uint64_t version{ 0 };
+                Info info;
+                bool withdraw{ false };
+            };
+
+            uint64_t version{ 0 };
+            std::deque<Change> changes;
+
+            void Add(const Info& info, bool withdraw)
+            {
+                changes.push_back({ ++version, info, withdraw });
+
+                if (changes.size() > kSyncLogMaxChanges) {
+                    changes.pop_front();
+                }
+            }
+
+            /**
+             * @brief Clear the change log; peers can no longer resume from a previous version
+             */
+            void Reset()
+            {
+                changes.clear();
+                version++;
+            }
+
+            /**
+             * @brief Check if all changes since last version are in the log
+             */
+            bool CanResume(uint64_t last_version) const
+            {
+                if (last_version == version) {
+                    return true;
+                }
+
+                return last_version < version && !changes.empty() && changes.front().version <= last_version + 1;
+            }
+
+            /**
+             * @brief Get the changes since last version, oldest first
+             */
+            std::vector<Change> ChangesSince(uint64_t last_version) const
+            {
+                auto it = std::upper_bound(changes.begin(),
+                                           changes.end(),
+                                           last_version,
+                                           [](uint64_t v, const Change& c) { return v < c.version; });
+
+                return { it, changes.end() };
+            }
+        };
+
+        /// Epoch of the change logs. Changes when the relay restarts, peers cannot resume from another epoch
+        const uint64_t sync_epoch_{ NewSyncEpoch() };
+
+        SyncLog<NodeInfo> nodes_sync_log_;           ///< Change log of nodes_, by node id
+        SyncLog<AnnounceInfo> announces_sync_log_;   ///< Change log of announces_
+        SyncLog<SubscribeInfo> subscribes_sync_log_; ///< Change log of subscribes_
+
         std::mutex mutex_;
 
       private:
+        /**
+         * @brief Candidate path to reach a node via a peer session
+         * @details Ordered by preference, which is not overloaded, lower path length (hops) and then lower
+         *      total sRTT weighted by the load of the next hop via relay.
+         */
+        struct PathCandidate
+        {
+            bool overloaded{ false }; ///< Next hop via relay is overloaded
+            std::size_t path_len{ 0 };
+            uint64_t weighted_srtt{ 0 }; ///< Sum sRTT increased by the CPU percent of the next hop via relay
+            PeerSessionId peer_session_id{ 0 };
+
+            auto operator<=>(const PathCandidate&) const = default;
+        };
+
+        /**
+         * @brief Next hop (direct peer) node of a peer session
+         */
+        struct NextHop
+        {
+            NodeIdValueType node_id{ 0 };
+            NodeLoad load;
+        };
+
+        PathCandidate MakePathCandidate(NodeIdValueType node_id,
+                                        PeerSessionId peer_session_id,
+                                        const NodeInfo& node_info) const;
+
+        /**
+         * @brief Add, update or remove (node_info is null) the candidate path of a node via a peer session
+         */
+        void SetPathCandidate(NodeIdValueType node_id, PeerSessionId peer_session_id, const NodeInfo* node_info);
+
+        /**
+         * @brief Remove node entry, including its candidate path
+         */
+        void EraseNode(decltype(nodes_)::iterator it);
+
         static std::vector<std::size_t> PrefixHashNamespaceTuples(const quicr::TrackNamespace& name_space);
+        static uint64_t NewSyncEpoch();
+
+        /**
+         * @brief Add or remove subscribe in the prefix lookup subscribe tables
+         */
+        void IndexSubscribe(const SubscribeInfo& subscribe_info, bool remove);
+
+        /**
+         * @brief Update the equal cost peer sessions for node id based on the current best
+         *
+         * @returns True if the set of equal cost peer sessions changed, false otherwise
+         */
+        bool UpdateMultipath(NodeIdValueType node_id);
+
+        std::size_t multipath_max_paths_{ 1 };
+        uint64_t multipath_srtt_margin_us_{ 0 };
+
+        /// Candidate paths by node id, ordered best first. Updated whenever nodes_ is updated
+        std::unordered_map<NodeIdValueType, std::set<PathCandidate>> node_paths_;
+
+        /// Current candidate path of each nodes_ entry, used to find the candidate in node_paths_
+        std::map<std::pair<NodeIdValueType, PeerSessionId>, PathCandidate> node_path_keys_;
+
+        /// Next hop node by peer session id, updated by node info received from the direct peer
+        std::unordered_map<PeerSessionId, NextHop> next_hops_;
+
+        /// Best selected peer session id for node id, same as nodes_best_
+        std::unordered_map<NodeIdValueType, PeerSessionId> nodes_best_id_;
+
+        /// Version of peer_fib_ entries by ingress peer session and SNS id. Leaf lock, taken after mutex_
+        std::mutex peer_fib_versions_mutex_;
+        std::map<std::pair<PeerSessionId, SubscribeNodeSetId>, std::shared_ptr<std::atomic<uint64_t>>>
+          peer_fib_versions_;
     };
 
 }
\ No newline at end of file
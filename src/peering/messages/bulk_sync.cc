@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "bulk_sync.h"
+
+namespace laps::peering {
+
+    BulkSync::BulkSync(std::span<const uint8_t> serialized_data)
+    {
+        auto it = serialized_data.begin();
+
+        while (it != serialized_data.end()) {
+            const auto type = static_cast<MsgType>(*it++);
+
+            if (it == serialized_data.end()) {
+                throw std::invalid_argument("Bulk sync entry is truncated");
+            }
+
+            const auto len_size = quicr::UintVar::Size(*it);
+            if (serialized_data.end() - it < static_cast<std::ptrdiff_t>(len_size)) {
+                throw std::invalid_argument("Bulk sync entry is truncated");
+            }
+
+            const auto len = uint64_t(quicr::UintVar({ it, it + len_size }));
+            it += len_size;
+
+            if (static_cast<uint64_t>(serialized_data.end() - it) < len) {
+                throw std::invalid_argument("Bulk sync entry is truncated");
+            }
+
+            entries.push_back({ type, { it, it + len } });
+            it += len;
+        }
+    }
+
+    void BulkSync::Clear()
+    {
+        data_.clear();
+        num_entries_ = 0;
+    }
+
+    uint32_t BulkSync::SizeBytes() const
+    {
+        return static_cast<uint32_t>(data_.size());
+    }
+
+    std::vector<uint8_t> BulkSync::Serialize(bool include_common_header) const
+    {
+        std::vector<uint8_t> data;
+
+        if (include_common_header) {
+            data.reserve(kCommonHeadersSize + SizeBytes());
+            data.push_back(kProtocolVersion);
+            uint16_t type = static_cast<uint16_t>(MsgType::kBulkSync);
+            auto type_bytes = BytesOf(type);
+            data.insert(data.end(), type_bytes.rbegin(), type_bytes.rend());
+            auto bs_size = SizeBytes();
+            auto data_len_bytes = BytesOf(bs_size);
+            data.insert(data.end(), data_len_bytes.rbegin(), data_len_bytes.rend());
+        } else {
+            data.reserve(SizeBytes());
+        }
+
+        data.insert(data.end(), data_.begin(), data_.end());
+        return data;
+    }
+}
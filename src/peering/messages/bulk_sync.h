@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+#pragma once
+
+#include "peering/common.h"
+
+#include <quicr/detail/uintvar.h>
+
+namespace laps::peering {
+
+    constexpr uint32_t kBulkSyncMaxBytes = 64'000; ///< Size in bytes to flush a bulk sync message
+
+    /**
+     * @brief Bulk sync of information base entries
+     *
+     * @details Bulk sync is used to synchronize the information base with a newly connected peer. Many node,
+     *    announce and subscribe advertisements are packed into a single control message. Each entry is the
+     *    message type, message length and the message without common headers. Entries are added until
+     *    the message is large enough to be sent, which allows the information base to be streamed in chunks.
+     */
+    class BulkSync
+    {
+      public:
+        struct Entry
+        {
+            MsgType type;                  ///< Message type of the entry
+            std::span<uint8_t const> data; ///< Message data, references the serialized data
+        };
+
+        /**
+         * Decoded entries. Entry data references the serialized data that was used to decode the
+         * bulk sync message, which must outlive the entries.
+         */
+        std::vector<Entry> entries;
+
+        /**
+         * @brief Add a message to the bulk sync
+         *
+         * @param type      Message type of the message
+         * @param msg       Message to encode, MUST support SizeBytes() and operator<<
+         */
+        template<typename T>
+        void Add(MsgType type, const T& msg)
+        {
+            const auto len = quicr::UintVar(msg.SizeBytes());
+
+            data_.push_back(static_cast<uint8_t>(type));
+            data_.insert(data_.end(), len.begin(), len.end());
+            data_ << msg;
+
+            num_entries_++;
+        }
+
+        /**
+         * @brief Clear added entries
+         */
+        void Clear();
+
+        std::size_t NumEntries() const { return num_entries_; }
+
+        /**
+         * @brief Encode added entries into bytes that can be written on the wire
+         */
+        std::vector<uint8_t> Serialize(bool include_common_header) const;
+
+        BulkSync() = default;
+        BulkSync(std::span<uint8_t const> serialized_data);
+
+        uint32_t SizeBytes() const;
+
+      private:
+        std::vector<uint8_t> data_; ///< Encoded entries
+        std::size_t num_entries_{ 0 };
+    };
+
+} // namespace laps
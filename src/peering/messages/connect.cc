@@ -34,7 +34,7 @@ namespace laps::peering {
         auto size = connect.SizeBytes();
 
         // Common header
-        data.push_back(kProtocolVersion);
+        data.push_back(connect.version);
         auto type_bytes = BytesOf(kConnectType);
         data.insert(data.end(), type_bytes.rbegin(), type_bytes.rend());
         auto data_len_bytes = BytesOf(size);
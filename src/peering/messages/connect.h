@@ -17,7 +17,8 @@ namespace laps::peering {
     class Connect
     {
       public:
-        PeerMode mode;      ///< Relay peering mode
+        uint8_t version{ kProtocolVersion }; ///< Protocol version of the client, set in common header
+        PeerMode mode;                       ///< Relay peering mode
         NodeInfo node_info; ///< node information of client making the connection
 
         /*
@@ -30,8 +30,8 @@ namespace laps::peering {
         // Get the size in bytes to be written
         auto size = connect_resp.SizeBytes();
 
-        // Common header
-        data.push_back(kProtocolVersion);
+        // Common header, version is the negotiated protocol version
+        data.push_back(connect_resp.version);
 
         auto type_bytes = BytesOf(kConnectResponseType);
         data.insert(data.end(), type_bytes.rbegin(), type_bytes.rend());
@@ -23,6 +23,24 @@ namespace laps::peering {
 
         uint32_t size = sizeof(header_len) + sizeof(type);
 
+        if (compact) {
+            switch (type) {
+                case DataType::kNewStream:
+                    size += sizeof(priority) + quicr::UintVar(ttl).Size();
+                    [[fallthrough]];
+
+                case DataType::kDatagram:
+                    size += quicr::UintVar(sns_id).Size();
+                    size += implicit_track ? 0 : sizeof(track_full_name_hash);
+                    break;
+
+                default:
+                    break;
+            }
+
+            return size;
+        }
+
         switch (type) {
             case DataType::kDatagram:
                 size += sizeof(sns_id) + sizeof(track_full_name_hash);
@@ -42,7 +60,8 @@ namespace laps::peering {
 
     DataHeader::DataHeader(std::span<const uint8_t> serialized_data)
     {
-        Deserialize(serialized_data);
+        if (!Deserialize(serialized_data))
+            throw std::invalid_argument("Serialized data is too short or invalid");
     }
 
     bool DataHeader::Deserialize(std::span<const uint8_t> serialized_data)
@@ -51,20 +70,90 @@ namespace laps::peering {
             return false;
         }
 
-        auto it = serialized_data.begin();
+        header_len = serialized_data.front();
 
-        header_len = *it++;
+        // Header length includes itself and the type
+        if (header_len < 2 || header_len > serialized_data.size()) {
+            return false;
+        }
 
-        if (header_len > serialized_data.size())
-            throw std::invalid_argument("Serialized data is too short");
+        // All reads are bounded by the header length, which is within the serialized data
+        auto it = serialized_data.begin() + 1;
+        const auto end = serialized_data.begin() + header_len;
+
+        const auto has_bytes = [&it, end](std::size_t len) { return static_cast<std::size_t>(end - it) >= len; };
+
+        const auto type_flags = *it++;
+        type = static_cast<DataType>(type_flags & kDataTypeMask);
+        compact = type_flags & kDataFlagCompact;
+        implicit_track = type_flags & kDataFlagImplicitTrack;
+
+        if (compact) {
+            const auto read_uintvar = [&it, &has_bytes](uint64_t& value) {
+                if (!has_bytes(1)) {
+                    return false;
+                }
+
+                const auto uv_len = quicr::UintVar::Size(*it);
+                if (!has_bytes(uv_len)) {
+                    return false;
+                }
+
+                value = uint64_t(quicr::UintVar({ it, it + uv_len }));
+                it += uv_len;
+                return true;
+            };
+
+            switch (type) {
+                case DataType::kDatagram:
+                    [[fallthrough]];
+                case DataType::kNewStream: {
+                    uint64_t value{ 0 };
+
+                    if (!read_uintvar(value)) {
+                        return false;
+                    }
+                    sns_id = static_cast<SubscribeNodeSetId>(value);
+
+                    if (!implicit_track) {
+                        if (!has_bytes(sizeof(track_full_name_hash))) {
+                            return false;
+                        }
+
+                        track_full_name_hash = ValueOf<uint64_t>({ it, it + 8 });
+                        it += 8;
+                    }
+
+                    if (type == DataType::kNewStream) {
+                        if (!has_bytes(sizeof(priority))) {
+                            return false;
+                        }
+                        priority = *it++;
+
+                        if (!read_uintvar(value)) {
+                            return false;
+                        }
+                        ttl = static_cast<uint32_t>(value);
+                    }
+                    break;
+                }
+
+                default:
+                    break;
+            }
 
-        type = static_cast<DataType>(*it++);
+            return true;
+        }
 
         switch (type) {
             case DataType::kExistingStream:
                 break;
 
             case DataType::kDatagram: {
+                if (!has_bytes(sizeof(sns_id) + sizeof(track_full_name_hash))) {
+                    return false;
+                }
+
                 sns_id = ValueOf<uint32_t>({ it, it + 4 });
                 it += 4;
 
@@ -75,6 +164,10 @@ namespace laps::peering {
             }
 
             case DataType::kNewStream: {
+                if (!has_bytes(sizeof(sns_id) + sizeof(track_full_name_hash) + sizeof(priority) + sizeof(ttl))) {
+                    return false;
+                }
+
                 sns_id = ValueOf<uint32_t>({ it, it + 4 });
                 it += 4;
 
@@ -98,9 +191,48 @@ namespace laps::peering {
             return data;
         }
 
-        data.push_back(data_object.header_len); // Will be set after knowing the full header size
-        uint8_t* header_len = &data[0];
-        *header_len = 2; // header length and type
+        const auto header_len_pos = data.size();
+        data.push_back(0); // Will be set after knowing the full header size
+
+        if (data_object.compact) {
+            uint8_t type_flags = static_cast<uint8_t>(data_object.type) | kDataFlagCompact;
+            if (data_object.implicit_track) {
+                type_flags |= kDataFlagImplicitTrack;
+            }
+
+            data.push_back(type_flags);
+
+            switch (data_object.type) {
+                case DataType::kDatagram:
+                    [[fallthrough]];
+                case DataType::kNewStream: {
+                    auto sns_id = quicr::UintVar(data_object.sns_id);
+                    data.insert(data.end(), sns_id.begin(), sns_id.end());
+
+                    // Hash values use all 64 bits, which cannot be encoded as a var-int
+                    if (!data_object.implicit_track) {
+                        auto tfn_bytes = BytesOf(data_object.track_full_name_hash);
+                        data.insert(data.end(), tfn_bytes.rbegin(), tfn_bytes.rend());
+                    }
+
+                    if (data_object.type == DataType::kNewStream) {
+                        data.push_back(data_object.priority);
+
+                        auto ttl = quicr::UintVar(data_object.ttl);
+                        data.insert(data.end(), ttl.begin(), ttl.end());
+                    }
+                    break;
+                }
+
+                default:
+                    break;
+            }
+
+            data[header_len_pos] = static_cast<uint8_t>(data.size() - header_len_pos);
+            return data;
+        }
+
+        data[header_len_pos] = 2; // header length and type
 
         data.push_back(static_cast<uint8_t>(data_object.type));
 
@@ -115,7 +247,7 @@ namespace laps::peering {
                 auto tfn_bytes = BytesOf(data_object.track_full_name_hash);
                 data.insert(data.end(), tfn_bytes.rbegin(), tfn_bytes.rend());
 
-                *header_len += sns_id_bytes.size() + tfn_bytes.size();
+                data[header_len_pos] += sns_id_bytes.size() + tfn_bytes.size();
                 break;
             }
 
@@ -131,7 +263,8 @@ namespace laps::peering {
                 auto ttl_bytes = BytesOf(data_object.ttl);
                 data.insert(data.end(), ttl_bytes.rbegin(), ttl_bytes.rend());
 
-                *header_len += sns_id_bytes.size() + tfn_bytes.size() + sizeof(data_object.priority) + ttl_bytes.size();
+                data[header_len_pos] +=
+                  sns_id_bytes.size() + tfn_bytes.size() + sizeof(data_object.priority) + ttl_bytes.size();
 
                 break;
             }
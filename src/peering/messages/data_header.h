@@ -20,6 +20,10 @@ namespace laps::peering {
         kFetchExistingStream,
     };
 
+    constexpr uint8_t kDataTypeMask = 0x3F;          ///< Data type bits of the type byte
+    constexpr uint8_t kDataFlagCompact = 0x80;       ///< Type flag; header fields are encoded as var-int
+    constexpr uint8_t kDataFlagImplicitTrack = 0x40; ///< Type flag; track full name hash is implied by SNS ID
+
     /**
      * @brief Data object to be sent to subscribers
      *
@@ -40,6 +44,9 @@ namespace laps::peering {
         uint8_t priority{ 1 }; ///< Stream only; Priority for new stream
         uint32_t ttl{ 2000 };  ///< Stream only; Time to live in millis for stream objects
 
+        bool compact{ false };        ///< Encode header using var-ints (protocol version 2)
+        bool implicit_track{ false }; ///< Compact only; track full name hash is not encoded, SNS ID implies it
+
         /**
          * @brief Encode data hader into bytes that can be written on the wire
          */
@@ -49,7 +56,7 @@ namespace laps::peering {
          * Deserialize read data from the network
          *
          * @param serialized_data
-         * @return True if successful, false if not enough data
+         * @return True if successful, false if not enough data or the header fields exceed the header length
          */
         bool Deserialize(std::span<uint8_t const> serialized_data);
 
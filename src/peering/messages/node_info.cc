@@ -17,11 +17,15 @@ namespace laps::peering {
 
     uint32_t NodeInfo::SizeBytes() const
     {
+        const uint32_t load_size =
+          with_load ? sizeof(load.cpu_pct) + sizeof(load.egress_kbps) + sizeof(load.active_tracks) : 0;
+
         return sizeof(id) + sizeof(type) + quicr::UintVar(contact.size()).Size() + contact.size() + sizeof(longitude) +
-               sizeof(latitude) + (path.size() * sizeof(NodePathItem));
+               sizeof(latitude) + load_size + (path.size() * sizeof(NodePathItem));
     }
 
-    NodeInfo::NodeInfo(std::span<uint8_t const> serialized_data)
+    NodeInfo::NodeInfo(std::span<uint8_t const> serialized_data, bool with_load)
+      : with_load(with_load)
     {
         auto it = serialized_data.begin();
 
@@ -42,6 +46,16 @@ namespace laps::peering {
         latitude = ValueOf<double>({ it, it + 8 });
         it += 8;
 
+        if (with_load) {
+            load.cpu_pct = *it++;
+
+            load.egress_kbps = ValueOf<uint32_t>({ it, it + 4 });
+            it += 4;
+
+            load.active_tracks = ValueOf<uint32_t>({ it, it + 4 });
+            it += 4;
+        }
+
         NodePathItem item;
         for (; it < serialized_data.end(); it += sizeof(NodePathItem)) {
             std::memcpy(&item, &*it, sizeof(NodePathItem));
@@ -66,6 +80,16 @@ namespace laps::peering {
         auto lat_bytes = BytesOf(node_info.latitude);
         data.insert(data.end(), lat_bytes.rbegin(), lat_bytes.rend());
 
+        if (node_info.with_load) {
+            data.push_back(node_info.load.cpu_pct);
+
+            auto egress_bytes = BytesOf(node_info.load.egress_kbps);
+            data.insert(data.end(), egress_bytes.rbegin(), egress_bytes.rend());
+
+            auto tracks_bytes = BytesOf(node_info.load.active_tracks);
+            data.insert(data.end(), tracks_bytes.rbegin(), tracks_bytes.rend());
+        }
+
         for (const auto& path_ni : node_info.path) {
             data.insert(data.end(),
                         reinterpret_cast<const uint8_t*>(&path_ni),
@@ -114,6 +114,25 @@ namespace laps::peering {
         uint64_t srtt_us{ 0 }; ///< SRTT in microseconds of the peer session that received the node info
     } __attribute__((__packed__, aligned(1)));
 
+    constexpr uint8_t kNodeLoadOverloadedCpuPct = 90;    ///< CPU percent at or above which a node is overloaded
+    constexpr uint8_t kNodeLoadAdvertiseCpuChangePct = 5; ///< CPU percent change to advertise node load
+
+    /**
+     * @brief Node load attributes
+     * @details Load of the relay, refreshed periodically from the relay counters. Load is advertised
+     *      only to peers that negotiated kProtocolVersionNodeLoad or greater.
+     */
+    struct NodeLoad
+    {
+        uint8_t cpu_pct{ 0 };        ///< Relay process CPU utilization in percent of all cores
+        uint32_t egress_kbps{ 0 };   ///< Egress transmit rate in kilobits per second
+        uint32_t active_tracks{ 0 }; ///< Number of tracks forwarded to peers
+
+        bool Overloaded() const { return cpu_pct >= kNodeLoadOverloadedCpuPct; }
+
+        bool operator==(const NodeLoad&) const = default;
+    };
+
     /**
      * @brief NodeInfo within the relay network
      *
@@ -132,6 +151,11 @@ namespace laps::peering {
         double longitude{ 0 }; ///< 8 byte longitude value detailing the location of the local relay
         double latitude{ 0 };  ///< 8 byte latitude value detailing the location of the local relay
 
+        NodeLoad load; ///< Load of the relay, zero if not advertised by the node
+
+        /// Encode load attributes. Only set when the peer negotiated kProtocolVersionNodeLoad or greater.
+        bool with_load{ false };
+
         /// Path of nodes that this node info has been seen by. When sending this node info, a new entry
         /// is added into this list upon sending. The value of this in the NIB does not contain self.
         std::vector<NodePathItem> path;
@@ -146,7 +170,13 @@ namespace laps::peering {
 
         NodeInfo() = default;
 
-        NodeInfo(std::span<uint8_t const> serialized);
+        /**
+         * @brief Decode node info
+         *
+         * @param serialized        Serialized node info, without common headers
+         * @param with_load         True to decode load attributes, peer negotiated kProtocolVersionNodeLoad
+         */
+        NodeInfo(std::span<uint8_t const> serialized, bool with_load = false);
 
         uint32_t SizeBytes() const;
 
@@ -3,6 +3,8 @@
 
 #include "subscribe_info.h"
 
+#include <algorithm>
+
 namespace laps::peering {
 
     SubscribeInfo::SubscribeInfo(quicr::TrackFullNameHash id,
@@ -13,10 +15,68 @@ namespace laps::peering {
     {
     }
 
+    std::shared_ptr<const SubscribeInfo::SubscribeView> SubscribeInfo::Decode(std::span<const uint8_t> data)
+    {
+        auto view = std::make_shared<SubscribeView>();
+
+        // subscribe headers in expected order, must each be parsed
+        auto msg_bytes = quicr::BytesSpan(data);
+        view->request_id = quicr::messages::Message::ParseField<std::uint64_t>(msg_bytes);
+        view->request_id_size = data.size() - msg_bytes.size();
+        view->track_namespace = quicr::messages::Message::ParseField<quicr::TrackNamespace>(msg_bytes);
+        view->track_name = quicr::messages::Message::ParseField<quicr::Bytes>(msg_bytes);
+        view->parameters = quicr::messages::Message::ParseField<quicr::messages::Parameters>(msg_bytes);
+
+        view->priority = view->parameters.Get<uint8_t>(quicr::messages::ParameterType::kSubscriberPriority);
+        view->new_group_request_id =
+          view->parameters.GetOptional<uint64_t>(quicr::messages::ParameterType::kNewGroupRequest);
+
+        for (const auto& param : view->parameters) {
+            if (param.type == quicr::messages::ParameterType::kNewGroupRequest) {
+                view->has_new_group_request = true;
+                break;
+            }
+        }
+
+        return view;
+    }
+
+    const SubscribeInfo::SubscribeView& SubscribeInfo::View() const
+    {
+        if (!view_) {
+            throw std::logic_error(subscribe_data_.empty() ? "Subscribe info has no subscribe data"
+                                                           : "Subscribe info subscribe data cannot be decoded");
+        }
+
+        return *view_;
+    }
+
+    bool SubscribeInfo::SameSubscribe(const SubscribeInfo& other) const
+    {
+        if (!view_ || !other.view_) {
+            return subscribe_data_ == other.subscribe_data_;
+        }
+
+        return std::ranges::equal(std::span(subscribe_data_).subspan(view_->request_id_size),
+                                  std::span(other.subscribe_data_).subspan(other.view_->request_id_size));
+    }
+
+    void SubscribeInfo::SetSubscribeData(std::span<const uint8_t> data)
+    {
+        subscribe_data_.assign(data.begin(), data.end());
+
+        // Subscribe data that cannot be decoded is still stored and forwarded, only use of the view fails
+        try {
+            view_ = Decode(subscribe_data_);
+        } catch (const std::exception&) {
+            view_.reset();
+        }
+    }
+
     uint32_t SubscribeInfo::SizeBytes() const
     {
         return sizeof(seq) + sizeof(source_node_id) + 24 /* namespace, name, and full name hashes */
-               + 4 /* size of sub data */ + subscribe_data.size();
+               + 4 /* size of sub data */ + subscribe_data_.size();
     }
 
     SubscribeInfo::SubscribeInfo(std::span<const uint8_t> serialized_data)
@@ -48,8 +108,7 @@ namespace laps::peering {
             throw std::out_of_range("Subscribe data size is larger than serialized data size");
         }
 
-        subscribe_data.assign(it, it + sub_size);
-        // it += sub_size;
+        SetSubscribeData({ it, it + sub_size });
     }
 
     std::vector<uint8_t>& operator<<(std::vector<uint8_t>& data, const SubscribeInfo& subscribe_info)
@@ -69,11 +128,13 @@ namespace laps::peering {
         auto full_name_bytes = BytesOf(subscribe_info.track_hash.track_fullname_hash);
         data.insert(data.end(), full_name_bytes.rbegin(), full_name_bytes.rend());
 
-        uint32_t sub_size = subscribe_info.subscribe_data.size();
+        const auto& subscribe_data = subscribe_info.SubscribeData();
+
+        uint32_t sub_size = subscribe_data.size();
         auto sub_size_bytes = BytesOf(sub_size);
         data.insert(data.end(), sub_size_bytes.rbegin(), sub_size_bytes.rend());
 
-        data.insert(data.end(), subscribe_info.subscribe_data.begin(), subscribe_info.subscribe_data.end());
+        data.insert(data.end(), subscribe_data.begin(), subscribe_data.end());
 
         return data;
     }
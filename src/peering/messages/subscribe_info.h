@@ -4,8 +4,10 @@
 
 #include "node_info.h"
 #include <memory>
+#include <optional>
 #include <set>
 
+#include <quicr/detail/messages.h>
 #include <quicr/track_name.h>
 
 namespace laps {
@@ -29,13 +31,59 @@ namespace laps::peering {
         NodeIdValueType source_node_id; ///< Id of the originating source node
 
         quicr::TrackHash track_hash; ///< Full name hash
-        std::vector<uint8_t>
-          subscribe_data; /// Original MoQ subscribe message (wire format) that initiated this subscribe
 
         // Data not in wire message (e.g., serialized)
 
+        /**
+         * @brief Decoded fields of the original MoQ subscribe message
+         */
+        struct SubscribeView
+        {
+            uint64_t request_id{ 0 };
+            quicr::TrackNamespace track_namespace;
+            quicr::Bytes track_name;
+            quicr::messages::Parameters parameters;
+
+            uint8_t priority{ 0 };                        ///< Subscriber priority parameter
+            std::optional<uint64_t> new_group_request_id; ///< New group request parameter value
+            bool has_new_group_request{ false };          ///< True if new group request parameter is present
+
+            std::size_t request_id_size{ 0 }; ///< Encoded size of the request id at the start of the data
+        };
+
         // End not serialized
 
+        /**
+         * @brief Get the decoded subscribe data
+         *
+         * @details Subscribe data is decoded when it is set or deserialized, the view is never modified
+         *    afterwards. Copies of this subscribe info share the decoded view.
+         *
+         * @throws std::logic_error if the subscribe info has no subscribe data or it cannot be decoded
+         */
+        const SubscribeView& View() const;
+
+        /**
+         * @brief Original MoQ subscribe message (wire format) that initiated this subscribe
+         */
+        const std::vector<uint8_t>& SubscribeData() const { return subscribe_data_; }
+
+        /**
+         * @brief Check if the subscribe data is the same subscribe, ignoring the request id
+         * @details A resubscribe carries a new request id. The namespace, name and parameters (e.g.,
+         *    priority and new group request) that peers act on are compared. Subscribe data that cannot
+         *    be decoded is compared as is.
+         */
+        bool SameSubscribe(const SubscribeInfo& other) const;
+
+        /**
+         * @brief Set and decode the subscribe data
+         *
+         * @details Subscribe data that cannot be decoded is kept so that it is still forwarded to peers.
+         *    The view is empty and View() throws at the point of use.
+         */
+        void SetSubscribeData(std::span<const uint8_t> data);
+
         /**
          * @brief Encode node object into bytes that can be written on the wire
          */
@@ -52,6 +100,10 @@ namespace laps::peering {
         uint32_t SizeBytes() const;
 
       private:
+        static std::shared_ptr<const SubscribeView> Decode(std::span<const uint8_t> data);
+
+        std::vector<uint8_t> subscribe_data_;       ///< Original MoQ subscribe message (wire format)
+        std::shared_ptr<const SubscribeView> view_; ///< Decoded view of subscribe_data_, empty if not decodable
     };
 
     std::vector<uint8_t>& operator<<(std::vector<uint8_t>& data, const SubscribeInfo& node_info);
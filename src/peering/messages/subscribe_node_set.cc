@@ -11,7 +11,8 @@ namespace laps::peering {
             return sizeof(SubscribeNodeSetId);
         }
 
-        return kSnsAdvHeaderSize + nodes.size() * sizeof(NodeIdValueType);
+        return kSnsAdvHeaderSize + nodes.size() * sizeof(NodeIdValueType) +
+               (track_fullname_hash ? sizeof(track_fullname_hash) : 0);
     }
 
     SubscribeNodeSet::SubscribeNodeSet(std::span<const uint8_t> serialized_data, bool withdraw)
@@ -31,6 +32,11 @@ namespace laps::peering {
                 nodes.emplace(ValueOf<NodeIdValueType>({ it, it + sizeof(NodeIdValueType) }));
                 it += sizeof(NodeIdValueType);
             }
+
+            // Optional track full name hash follows the nodes. Older peers do not include it
+            if (serialized_data.end() - it >= static_cast<std::ptrdiff_t>(sizeof(track_fullname_hash))) {
+                track_fullname_hash = ValueOf<uint64_t>({ it, it + sizeof(track_fullname_hash) });
+            }
         }
     }
 
@@ -50,6 +56,11 @@ namespace laps::peering {
             data.insert(data.end(), node_id_bytes.rbegin(), node_id_bytes.rend());
         }
 
+        if (sns.track_fullname_hash) {
+            auto tfn_bytes = BytesOf(sns.track_fullname_hash);
+            data.insert(data.end(), tfn_bytes.rbegin(), tfn_bytes.rend());
+        }
+
         return data;
     }
 
@@ -27,6 +27,10 @@ namespace laps::peering {
         uint8_t priority{ 2 };           ///< Priority to use for data context
         std::set<NodeIdValueType> nodes; ///< Set of source nodes for each subscriber
 
+        /// Optional track full name hash of the SNS. Zero if not known. When set, data headers
+        /// can omit the track full name hash (implicit track)
+        quicr::TrackFullNameHash track_fullname_hash{ 0 };
+
         /**
          * @brief Encode node object into bytes that can be written on the wire
          */
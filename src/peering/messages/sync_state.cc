@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "sync_state.h"
+
+namespace laps::peering {
+
+    uint32_t SyncState::SizeBytes() const
+    {
+        // clang-format off
+        return   sizeof(epoch)
+               + quicr::UintVar(nodes_version).Size()
+               + quicr::UintVar(announces_version).Size()
+               + quicr::UintVar(subscribes_version).Size()
+               + sizeof(flags);
+        // clang-format on
+    }
+
+    SyncState::SyncState(std::span<const uint8_t> serialized_data)
+    {
+        if (serialized_data.size() < sizeof(epoch) + 4) {
+            throw std::invalid_argument("Serialized sync state is too short");
+        }
+
+        auto it = serialized_data.begin();
+
+        epoch = ValueOf<uint64_t>({ it, it + 8 });
+        it += 8;
+
+        const auto read_uintvar = [&]() {
+            const auto uv_len = quicr::UintVar::Size(*it);
+            if (serialized_data.end() - it < static_cast<std::ptrdiff_t>(uv_len)) {
+                throw std::invalid_argument("Serialized sync state is too short");
+            }
+
+            const auto value = uint64_t(quicr::UintVar({ it, it + uv_len }));
+            it += uv_len;
+            return value;
+        };
+
+        nodes_version = read_uintvar();
+        announces_version = read_uintvar();
+        subscribes_version = read_uintvar();
+
+        if (it == serialized_data.end()) {
+            throw std::invalid_argument("Serialized sync state is too short");
+        }
+
+        flags = *it++;
+    }
+
+    std::vector<uint8_t>& operator<<(std::vector<uint8_t>& data, const SyncState& sync_state)
+    {
+        auto epoch_bytes = BytesOf(sync_state.epoch);
+        data.insert(data.end(), epoch_bytes.rbegin(), epoch_bytes.rend());
+
+        for (const auto version :
+             { sync_state.nodes_version, sync_state.announces_version, sync_state.subscribes_version }) {
+            auto version_uv = quicr::UintVar(version);
+            data.insert(data.end(), version_uv.begin(), version_uv.end());
+        }
+
+        data.push_back(sync_state.flags);
+
+        return data;
+    }
+
+    std::vector<uint8_t> SyncState::Serialize(bool include_common_header, bool request) const
+    {
+        std::vector<uint8_t> data;
+
+        if (include_common_header) {
+            data.reserve(kCommonHeadersSize + SizeBytes());
+            data.push_back(kProtocolVersion);
+            uint16_t type = static_cast<uint16_t>(request ? MsgType::kSyncRequest : MsgType::kSyncState);
+            auto type_bytes = BytesOf(type);
+            data.insert(data.end(), type_bytes.rbegin(), type_bytes.rend());
+            auto ss_size = SizeBytes();
+            auto data_len_bytes = BytesOf(ss_size);
+            data.insert(data.end(), data_len_bytes.rbegin(), data_len_bytes.rend());
+        } else {
+            data.reserve(SizeBytes());
+        }
+
+        data << *this;
+        return data;
+    }
+}
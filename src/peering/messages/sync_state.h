@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+#pragma once
+
+#include "peering/common.h"
+
+#include <quicr/detail/uintvar.h>
+
+namespace laps::peering {
+
+    constexpr uint8_t kSyncFlagNodesResumed = 0x01;      ///< Node info is sent as changes since the requested version
+    constexpr uint8_t kSyncFlagAnnouncesResumed = 0x02;  ///< Announce info is sent as changes since requested version
+    constexpr uint8_t kSyncFlagSubscribesResumed = 0x04; ///< Subscribe info is sent as changes since requested version
+    constexpr uint8_t kSyncFlagDone = 0x80;              ///< Sync is complete, versions are the synced versions
+
+    /**
+     * @brief Information base sync state
+     *
+     * @details Sync state is exchanged to resume information base sync after a peer reconnects. The receiving
+     *    side of a sync sends SYNC_REQUEST with the epoch and table versions it last completed a sync with.
+     *    The sending side replies with SYNC_STATE indicating which tables are resumed (changes only) followed by
+     *    the entries and a final SYNC_STATE with the done flag and the versions that were synced.
+     */
+    class SyncState
+    {
+      public:
+        uint64_t epoch{ 0 };              ///< Information base epoch of the sender, zero is unknown
+        uint64_t nodes_version{ 0 };      ///< Node info table version
+        uint64_t announces_version{ 0 };  ///< Announce info table version
+        uint64_t subscribes_version{ 0 }; ///< Subscribe info table version
+        uint8_t flags{ 0 };               ///< Sync flags, SYNC_STATE only
+
+        /**
+         * @brief Encode sync state into bytes that can be written on the wire
+         *
+         * @param include_common_header     True to add the common header
+         * @param request                   True to encode as SYNC_REQUEST, false for SYNC_STATE
+         */
+        std::vector<uint8_t> Serialize(bool include_common_header, bool request = false) const;
+
+        SyncState() = default;
+        SyncState(std::span<uint8_t const> serialized_data);
+
+        uint32_t SizeBytes() const;
+
+      private:
+    };
+
+    std::vector<uint8_t>& operator<<(std::vector<uint8_t>& data, const SyncState& sync_state);
+
+} // namespace laps
@@ -8,7 +8,10 @@
 #include <peering/messages/data_header.h>
 
 #include "subscribe_handler.h"
+#include <algorithm>
 #include <chrono>
+#include <cstdlib>
+#include <limits>
 
 namespace laps::peering {
 
@@ -27,20 +30,29 @@ namespace laps::peering {
 
         auto peer_session = GetPeerSession(peer_session_id);
 
+        std::vector<InfoBase::BestPathChange> changes;
+
         if (not withdraw) {
-            if (info_base_->AddNode(peer_session, node_info)) {
+            changes = info_base_->AddNode(peer_session, node_info);
+
+            if (std::ranges::any_of(changes, [&node_info](const auto& change) {
+                    return change.node_id == node_info.id && change.peer_session_id.has_value() &&
+                           change.BestChanged();
+                })) {
                 // Add peer to path before advertising node
                 auto adv_node_info = node_info;
                 adv_node_info.path.push_back({ adv_node_info.id, peer_session->metrics_.srtt_us });
                 PropagateNodeInfo(adv_node_info);
             }
         } else {
-            info_base_->RemoveNode(peer_session_id, node_info.id);
+            changes = info_base_->RemoveNode(peer_session_id, node_info.id);
 
             auto adv_node_info = node_info;
             adv_node_info.path.push_back({ peer_session->node_info_.id, peer_session->metrics_.srtt_us });
             PropagateNodeInfo(adv_node_info, true);
         }
+
+        ApplyBestPathChanges(changes);
     } catch (const std::exception&) {
         SPDLOG_LOGGER_DEBUG(LOGGER,
                             "Cannot find peer session {} to process node info received id: {} contact: {}",
@@ -49,6 +61,76 @@ namespace laps::peering {
                             node_info.contact);
     }
 
+    void PeerManager::ApplyBestPathChanges(const std::vector<InfoBase::BestPathChange>& changes,
+                                           std::optional<NodeIdValueType> skip_node_id)
+    {
+        std::vector<std::pair<PeerSessionId, SubscribeInfo>> remove_sub;
+        std::vector<std::pair<PeerSessionId, SubscribeInfo>> update_sub;
+
+        for (const auto& change : changes) {
+            SPDLOG_LOGGER_DEBUG(LOGGER,
+                                "Paths changed node id: {} prev peer_session_id: {} new peer_session_id: {}",
+                                NodeId().Value(change.node_id),
+                                change.prev_peer_session_id.value_or(0),
+                                change.peer_session_id.value_or(0));
+
+            // New nodes have no subscribes using a path to them yet
+            if (!change.prev_peer_session_id.has_value() || change.node_id == skip_node_id) {
+                continue;
+            }
+
+            const auto prev_peer_session_id = *change.prev_peer_session_id;
+
+            for (auto& si : info_base_->GetSubscribesBySourceNode(change.node_id)) {
+                if (!change.peer_session_id.has_value()) {
+                    // No best path found, remove. Withdraw uses the client FIB entry to find the peer session
+                    remove_sub.emplace_back(prev_peer_session_id, std::move(si));
+                    continue;
+                }
+
+                const auto fullname_hash = si.track_hash.track_fullname_hash;
+                const auto flow_peer_session = info_base_->GetPeerSessionForFlow(change.node_id, fullname_hash).lock();
+
+                std::shared_ptr<PeerSession> fib_peer_session;
+                {
+                    std::lock_guard _(info_base_->mutex_);
+                    auto it = info_base_->client_fib_.find({ fullname_hash, prev_peer_session_id });
+                    if (it == info_base_->client_fib_.end())
+                        continue;
+
+                    fib_peer_session = it->second.peer_session.lock();
+
+                    // Flow still uses the same peer session, only the entry key follows the best
+                    if (fib_peer_session != nullptr && fib_peer_session == flow_peer_session) {
+                        if (change.BestChanged()) {
+                            auto entry = info_base_->client_fib_.extract(it);
+                            entry.key().second = *change.peer_session_id;
+                            info_base_->client_fib_.insert(std::move(entry));
+                        }
+                        continue;
+                    }
+
+                    info_base_->client_fib_.erase(it);
+                }
+
+                // Peer session left the paths or the flow hashes to another one, move the source node to it
+                if (fib_peer_session != nullptr) {
+                    fib_peer_session->RemoveSubscribeSourceNode(fullname_hash, si.source_node_id);
+                }
+
+                update_sub.emplace_back(*change.peer_session_id, std::move(si));
+            }
+        }
+
+        for (auto& [id, si] : remove_sub) {
+            SubscribeInfoReceived(id, si, true);
+        }
+
+        for (auto& [id, si] : update_sub) {
+            SubscribeInfoReceived(id, si, false);
+        }
+    }
+
     bool PeerManager::HasSubscribers(uint64_t track_fullname_hash)
     {
         for (auto it = info_base_->client_fib_.lower_bound({ track_fullname_hash, 0 });
@@ -82,7 +164,7 @@ namespace laps::peering {
           withdraw ? info_base_->RemoveSubscribe(subscribe_info) : info_base_->AddSubscribe(subscribe_info);
 
         if (is_updated) {
-            for (const auto& sess : client_peer_sessions_) {
+            for (const auto& sess : ClientPeerSessions()) {
                 if (peer_session_id != sess.first)
                     sess.second->SendSubscribeInfo(subscribe_info, withdraw);
             }
@@ -101,41 +183,20 @@ namespace laps::peering {
         if (not withdraw) {
             uint64_t update_ref = rand();
 
-            auto msg_bytes = quicr::BytesSpan(subscribe_info.subscribe_data);
+            const auto& sub_view = subscribe_info.View();
+            const auto& track_namespace = sub_view.track_namespace;
+            const auto& track_name = sub_view.track_name;
 
-            // subscribe headers in expected order, must each be parsed
-            [[maybe_unused]] const auto request_id = quicr::messages::Message::ParseField<std::uint64_t>(msg_bytes);
-            const auto track_namespace = quicr::messages::Message::ParseField<quicr::TrackNamespace>(msg_bytes);
-            const auto track_name = quicr::messages::Message::ParseField<quicr::Bytes>(msg_bytes);
-            const auto parameters = quicr::messages::Message::ParseField<quicr::messages::Parameters>(msg_bytes);
-
-            auto tfn = quicr::FullTrackName{ track_namespace, track_name };
-
-            auto priority = parameters.Get<uint8_t>(quicr::messages::ParameterType::kSubscriberPriority);
-            auto ngr_id = parameters.GetOptional<uint64_t>(quicr::messages::ParameterType::kNewGroupRequest);
+            auto priority = sub_view.priority;
+            auto ngr_id = sub_view.new_group_request_id;
 
             std::lock_guard _(state_.state_mutex);
-            bool announce_matches{ false };
-            for (auto it = state_.pub_subscribes.lower_bound({ subscribe_info.track_hash.track_fullname_hash, 0 });
-                 it != state_.pub_subscribes.end();
-                 ++it) {
-
-                if (it->first.first != subscribe_info.track_hash.track_fullname_hash) {
-                    break;
-                }
-
-                announce_matches = true;
-            }
+            bool announce_matches =
+              !state_.pub_subscribes.Connections(subscribe_info.track_hash.track_fullname_hash).empty();
 
             // If no publish, then check announces
             if (not announce_matches) {
-                for (auto& [key, track_aliases] : state_.pub_namespace_active) {
-                    if (!key.first.HasSamePrefix(track_namespace)) {
-                        continue;
-                    }
-                    announce_matches = true;
-                    break;
-                }
+                announce_matches = !state_.pub_namespace_active_index.Matching(track_namespace).empty();
             }
 
             if (announce_matches) {
@@ -158,9 +219,9 @@ namespace laps::peering {
                       0, 0, subscribe_info.track_hash, { track_namespace, track_name }, s_attrs, std::nullopt);
                 }
 
-                auto bp_it = info_base_->nodes_best_.find(subscribe_info.source_node_id);
-                if (bp_it != info_base_->nodes_best_.end()) {
-                    const auto& peer_session = bp_it->second.lock();
+                auto peer_session_weak = info_base_->GetPeerSessionForFlow(
+                  subscribe_info.source_node_id, subscribe_info.track_hash.track_fullname_hash);
+                if (const auto peer_session = peer_session_weak.lock()) {
                     SPDLOG_LOGGER_DEBUG(
                       LOGGER,
                       "Best peer session for subscribe fullname: {} source_node: {} is via peer_session_id: {}",
@@ -182,7 +243,7 @@ namespace laps::peering {
 
                         if (auto [_, is_new] = info_base_->client_fib_.try_emplace(
                               { subscribe_info.track_hash.track_fullname_hash, peer_session_id },
-                              InfoBase::FibEntry{ update_ref, {}, sns_id, bp_it->second });
+                              InfoBase::FibEntry{ update_ref, {}, sns_id, peer_session_weak });
                             is_new) {
                             SPDLOG_LOGGER_INFO(LOGGER,
                                                "New subscribe fullname: {}, sending subscribe to client manager",
@@ -192,9 +253,18 @@ namespace laps::peering {
                 }
             }
         } else {
-            auto bp_it = info_base_->nodes_best_.find(subscribe_info.source_node_id);
-            if (bp_it != info_base_->nodes_best_.end()) {
-                const auto& peer_session = bp_it->second.lock();
+            /*
+             * Use the peer session that the source node was added to. Equal cost paths can change since, which
+             * moves flows, so the peer session for the flow is not always the one that has the source node.
+             */
+            std::shared_ptr<PeerSession> fib_peer_session;
+            if (const auto fib_it =
+                  info_base_->client_fib_.find({ subscribe_info.track_hash.track_fullname_hash, peer_session_id });
+                fib_it != info_base_->client_fib_.end()) {
+                fib_peer_session = fib_it->second.peer_session.lock();
+            }
+
+            if (const auto& peer_session = fib_peer_session) {
                 if (const auto [_, sns_removed] = peer_session->RemoveSubscribeSourceNode(
                       subscribe_info.track_hash.track_fullname_hash, subscribe_info.source_node_id);
                     sns_removed) {
@@ -251,7 +321,7 @@ namespace laps::peering {
             return;
         }
 
-        for (const auto& sess : client_peer_sessions_) {
+        for (const auto& sess : ClientPeerSessions()) {
             if (peer_session_id != sess.first)
                 sess.second->SendAnnounceInfo(announce_info, withdraw);
         }
@@ -304,6 +374,12 @@ namespace laps::peering {
             case PeerSession::StatusValue::kConnected: {
                 SPDLOG_LOGGER_INFO(LOGGER, "Peer session connected peer_session_id: {}", peer_session_id);
 
+                // Reset reconnect backoff of outbound peer
+                if (const auto key = ReconnectKey(peer_session_id); !key.empty()) {
+                    std::lock_guard _(check_mutex_);
+                    reconnect_attempts_.erase(key);
+                }
+
                 break;
             }
             case PeerSession::StatusValue::kConnecting:
@@ -314,55 +390,30 @@ namespace laps::peering {
 
                 PropagateNodeInfo(remote_node_info, true);
 
+                std::vector<InfoBase::BestPathChange> changes;
                 if (!stop_)
-                    info_base_->PurgePeerSessionInfo(peer_session_id);
-
-                // Remove or find new best peer for subscribe info
-                std::vector<SubscribeInfo> remove_sub;
-                std::vector<std::pair<PeerSessionId, SubscribeInfo>> update_sub;
-                std::unique_lock<std::mutex> ib_lock(info_base_->mutex_);
-                for (const auto& subs : info_base_->subscribes_) {
-                    auto sub_it = subs.second.find(remote_node_info.id);
-                    if (sub_it != subs.second.end()) {
-                        remove_sub.emplace_back(sub_it->second);
-                    } else {
-                        /*
-                         * check if peer session was used as best path for subscription. If so, try to find another
-                         *      best path. If no best path can be found, remove subscribe info.
-                         */
-                        for (auto& [_, si] : subs.second) {
-                            auto cfib_it =
-                              info_base_->client_fib_.find({ si.track_hash.track_fullname_hash, peer_session_id });
-                            if (cfib_it != info_base_->client_fib_.end()) {
-                                info_base_->client_fib_.erase(cfib_it);
-                                auto best_peer = info_base_->GetBestPeerSession(si.source_node_id);
-                                if (const auto& peer_sess = best_peer.lock()) {
-                                    // best path found, update entry to use new path
-                                    update_sub.emplace_back(peer_sess->GetSessionId(), si);
-                                } else {
-                                    // No best path found, remove
-                                    remove_sub.emplace_back(sub_it->second);
-                                }
-                            }
-                        }
-                    }
-                }
-                ib_lock.unlock();
+                    changes = info_base_->PurgePeerSessionInfo(peer_session_id);
 
-                for (auto& si : remove_sub) {
+                // Remove subscribes of the remote node, and remove or find new best peer for subscribes of
+                // nodes with a best path change
+                for (auto& si : info_base_->GetSubscribesBySourceNode(remote_node_info.id)) {
                     SubscribeInfoReceived(peer_session_id, si, true);
                 }
 
-                for (auto& [id, si] : update_sub) {
-                    SubscribeInfoReceived(id, si, false);
-                }
+                ApplyBestPathChanges(changes, remote_node_info.id);
+
+                // Reconnect outbound peer session
+                ScheduleReconnect(peer_session_id);
 
                 // Remove all announces if no active peering sessions exists
                 bool remove_announce{ true };
-                for (const auto& [id, peer_sess] : client_peer_sessions_) {
-                    if (peer_sess->Status() == PeerSession::StatusValue::kConnected) {
-                        remove_announce = false;
-                        break;
+                {
+                    std::lock_guard _(mutex_);
+                    for (const auto& [id, peer_sess] : client_peer_sessions_) {
+                        if (peer_sess->Status() == PeerSession::StatusValue::kConnected) {
+                            remove_announce = false;
+                            break;
+                        }
                     }
                 }
 
@@ -376,7 +427,7 @@ namespace laps::peering {
                 }
 
                 if (remove_announce) {
-                    info_base_->announces_.clear();
+                    info_base_->ClearAnnounces();
                 }
 
                 break;
@@ -395,9 +446,6 @@ namespace laps::peering {
         std::unique_lock _(info_base_->mutex_); // TODO: See about removing this lock
         auto it = info_base_->peer_fib_.find({ peer_session_id, data_header.sns_id });
         if (it != info_base_->peer_fib_.end()) {
-            // TODO(tievens): Replace data_out with new transport multiple data
-            std::vector data_out(data->begin(), data->end());
-
             for (auto& [out_peer_sess_id, entry] : it->second) {
                 if (out_peer_sess_id == peer_session_id)
                     continue; // Skip; don't send back to same peer or if it's self
@@ -431,13 +479,10 @@ namespace laps::peering {
                     continue;
                 }
 
-                // Update SNS_ID if new stream header included or if datagram (both have sns_id)
-                if (is_new_stream || eflags.use_reliable == false) {
-                    auto sns_id_bytes = BytesOf(entry.out_sns_id);
-                    std::copy(sns_id_bytes.rbegin(), sns_id_bytes.rend(), data_out.begin() + 2);
-                }
-
                 auto out_peer_sess = entry.peer_session.lock();
+                if (not out_peer_sess) {
+                    continue;
+                }
 
                 uint64_t out_stream_id{ 0 };
                 if (eflags.use_reliable) {
@@ -455,14 +500,21 @@ namespace laps::peering {
                     }
                 }
 
-                auto data_out_shared = std::make_shared<std::vector<uint8_t>>();
-                data_out_shared->assign(data_out.begin(), data_out.end());
+                // Encode header with egress SNS_ID if new stream header included or if datagram (both have sns_id)
+                auto data_out = data;
+                if (is_new_stream || eflags.use_reliable == false) {
+                    data_out = out_peer_sess->EncodeData(data_header,
+                                                         entry.out_sns_id,
+                                                         entry.track_fullname_hash != 0,
+                                                         { data->begin() + data_offset, data->end() });
+                }
+
                 out_peer_sess->SendData(data_header.priority,
                                         data_header.ttl,
                                         entry.out_sns_id,
                                         out_stream_id,
                                         eflags,
-                                        std::move(data_out_shared));
+                                        std::move(data_out));
             }
         } else {
             SPDLOG_LOGGER_DEBUG(config_.logger_,
@@ -472,17 +524,74 @@ namespace laps::peering {
         }
     }
 
+    bool PeerManager::ResolveStreamEgress(PeerSessionId peer_session_id,
+                                          uint64_t stream_id,
+                                          bool is_new_stream,
+                                          DataStreamContext& stream_ctx)
+    {
+        std::unique_lock _(info_base_->mutex_);
+
+        stream_ctx.egress.clear();
+
+        // Read the version before the entry, a change after this is detected by the next chunk
+        stream_ctx.fib_version = info_base_->GetPeerFibVersion(peer_session_id, stream_ctx.data_header.sns_id);
+        stream_ctx.resolved_fib_version = *stream_ctx.fib_version;
+
+        auto it = info_base_->peer_fib_.find({ peer_session_id, stream_ctx.data_header.sns_id });
+        if (it == info_base_->peer_fib_.end()) {
+            SPDLOG_LOGGER_DEBUG(config_.logger_,
+                                "Peer stream received has no peers peer_sess_id: {} in_sns_id: {}",
+                                peer_session_id,
+                                stream_ctx.data_header.sns_id);
+            return true; // Nothing to forward, drop stream data
+        }
+
+        if (it->second.contains(0)) {
+            return false; // Client manager is interested, stream data needs to be parsed
+        }
+
+        stream_ctx.egress.reserve(it->second.size());
+
+        for (auto& [out_peer_sess_id, entry] : it->second) {
+            if (out_peer_sess_id == peer_session_id)
+                continue; // Skip; don't send back to same peer
+
+            auto out_peer_sess = entry.peer_session.lock();
+            if (not out_peer_sess) {
+                continue;
+            }
+
+            auto sid_it = entry.streams.find(stream_id);
+            if (sid_it == entry.streams.end()) {
+                if (!is_new_stream) {
+                    continue; // Egress added after start of stream, wait for next new stream
+                }
+
+                sid_it =
+                  entry.streams
+                    .emplace(stream_id, out_peer_sess->CreateStream(entry.out_sns_id, stream_ctx.data_header.priority))
+                    .first;
+            }
+
+            stream_ctx.egress.push_back(
+              { entry.peer_session, entry.out_sns_id, sid_it->second, entry.track_fullname_hash != 0 });
+        }
+
+        return true;
+    }
+
     std::set<NodeIdValueType> PeerManager::GetOriginNodeId(quicr::FullTrackName full_name)
     {
         return info_base_->GetAnnounceIds(full_name.name_space, full_name.name, false);
     }
 
     void PeerManager::EndSubgroup(quicr::TrackFullNameHash track_full_name_hash,
+                                  quicr::ConnectionHandle connection_handle,
                                   uint64_t group_id,
                                   uint64_t subgroup_id,
                                   bool reset)
     {
-        uint64_t in_stream_id = group_id << 16 | static_cast<uint16_t>(subgroup_id);
+        const InfoBase::ClientStreamKey in_stream_key{ connection_handle, group_id, subgroup_id };
 
         for (auto it = info_base_->client_fib_.lower_bound({ track_full_name_hash, 0 });
              it != info_base_->client_fib_.end();
@@ -493,25 +602,26 @@ namespace laps::peering {
                 break;
 
             if (const auto peer_sess = fib_entry.peer_session.lock()) {
-                SPDLOG_LOGGER_DEBUG(LOGGER,
-                                    "Client end group: {} subgroup: {}, peer_session: {} egress SNS_ID: {}",
-                                    group_id,
-                                    subgroup_id,
-                                    peer_sess->GetSessionId(),
-                                    fib_entry.out_sns_id);
-
-                auto stream_it = fib_entry.streams.find(in_stream_id);
-                if (stream_it != fib_entry.streams.end()) {
+                SPDLOG_LOGGER_DEBUG(
+                  LOGGER,
+                  "Client end conn_id: {} group: {} subgroup: {}, peer_session: {} egress SNS_ID: {}",
+                  connection_handle,
+                  group_id,
+                  subgroup_id,
+                  peer_sess->GetSessionId(),
+                  fib_entry.out_sns_id);
+
+                if (const auto out_stream_id = fib_entry.EraseClientStream(in_stream_key)) {
                     peer_sess->CloseStream(fib_entry.out_sns_id,
-                                           stream_it->second,
+                                           *out_stream_id,
                                            reset ? quicr::StreamClosedFlag::kReset : quicr::StreamClosedFlag::kFin);
-                    fib_entry.streams.erase(stream_it);
                 }
             }
         }
     }
 
     void PeerManager::ClientDataRecv(quicr::TrackFullNameHash track_full_name_hash,
+                                     quicr::ConnectionHandle connection_handle,
                                      uint8_t priority,
                                      uint32_t ttl,
                                      DataType type,
@@ -525,9 +635,6 @@ namespace laps::peering {
         data_header.ttl = ttl;
         data_header.track_full_name_hash = track_full_name_hash;
 
-        auto net_data = std::make_shared<std::vector<uint8_t>>(data_header.Serialize());
-        net_data->insert(net_data->end(), data->begin(), data->end());
-
         quicr::ITransport::EnqueueFlags eflags;
 
         bool set_sns_id{ false };
@@ -560,43 +667,41 @@ namespace laps::peering {
                                     fib_entry.out_sns_id,
                                     track_full_name_hash);
 
-                auto send_data = net_data;
+                // Existing stream data has no header. Client SNS is per track, so the track is always known
+                auto send_data = data;
                 if (set_sns_id) {
-                    send_data = std::make_shared<std::vector<uint8_t>>(*net_data);
-                    auto sns_id_bytes = BytesOf(fib_entry.out_sns_id);
-                    std::copy(sns_id_bytes.rbegin(), sns_id_bytes.rend(), send_data->begin() + 2);
+                    send_data = peer_sess->EncodeData(data_header, fib_entry.out_sns_id, true, *data);
                 }
 
                 uint64_t out_stream_id{ 0 };
 
                 if (eflags.use_reliable) {
-                    uint64_t in_stream_id = group_id << 16 | static_cast<uint16_t>(subgroup_id);
+                    const InfoBase::ClientStreamKey in_stream_key{ connection_handle, group_id, subgroup_id };
 
-                    auto stream_it = fib_entry.streams.find(in_stream_id);
-                    if (stream_it == fib_entry.streams.end()) {
+                    auto stream_it = fib_entry.client_streams.find(in_stream_key);
+                    if (stream_it == fib_entry.client_streams.end()) {
                         if (data_header.type != DataType::kNewStream) {
                             return;
                         }
 
                         out_stream_id = peer_sess->CreateStream(fib_entry.out_sns_id, priority);
-                        fib_entry.streams.try_emplace(in_stream_id, out_stream_id);
+                        fib_entry.client_streams.try_emplace(in_stream_key, out_stream_id);
                     } else {
                         out_stream_id = stream_it->second;
                     }
 
                     SPDLOG_LOGGER_TRACE(
                       LOGGER,
-                      "Data object send, peer_session: {} egress SNS_ID: {} in stream_id: {} out "
+                      "Data object send, peer_session: {} egress SNS_ID: {} out "
                       "stream_id: {} tfn_hash: {} group_id: {} subgroup_id: {} streams: {} data len: {}",
                       peer_sess->GetSessionId(),
                       fib_entry.out_sns_id,
-                      in_stream_id,
                       out_stream_id,
                       track_full_name_hash,
                       group_id,
                       subgroup_id,
-                      fib_entry.streams.size(),
-                      net_data->size());
+                      fib_entry.client_streams.size(),
+                      send_data->size());
                 }
 
                 peer_sess->SendData(priority, ttl, fib_entry.out_sns_id, out_stream_id, eflags, send_data);
@@ -605,11 +710,56 @@ namespace laps::peering {
     }
 
     void PeerManager::ClientUnsubscribe(uint64_t track_fullname_hash)
+    {
+        if (config_.peering.unsubscribe_holddown_ms == 0 || stop_) {
+            WithdrawSubscribe(track_fullname_hash, ClientPeerSessions());
+            return;
+        }
+
+        std::lock_guard _(check_mutex_);
+
+        const auto due_ms = CurrentTickMs() + config_.peering.unsubscribe_holddown_ms;
+        if (!unsubscribe_pending_.try_emplace(track_fullname_hash, due_ms).second) {
+            return; // Already scheduled
+        }
+
+        unsubscribe_timers_.emplace(due_ms, track_fullname_hash);
+
+        SPDLOG_LOGGER_DEBUG(LOGGER,
+                            "Scheduled subscribe withdraw fullname: {} in {} ms",
+                            track_fullname_hash,
+                            config_.peering.unsubscribe_holddown_ms);
+
+        check_cv_.notify_one();
+    }
+
+    bool PeerManager::CancelWithdrawSubscribe(uint64_t track_fullname_hash)
+    {
+        std::lock_guard _(check_mutex_);
+
+        auto it = unsubscribe_pending_.find(track_fullname_hash);
+        if (it == unsubscribe_pending_.end()) {
+            return false;
+        }
+
+        auto [t_it, t_end] = unsubscribe_timers_.equal_range(it->second);
+        for (; t_it != t_end; ++t_it) {
+            if (t_it->second == track_fullname_hash) {
+                unsubscribe_timers_.erase(t_it);
+                break;
+            }
+        }
+
+        unsubscribe_pending_.erase(it);
+        return true;
+    }
+
+    void PeerManager::WithdrawSubscribe(uint64_t track_fullname_hash, const PeerSessionList& client_peer_sessions)
     {
         if (auto si = info_base_->GetSubscribe(track_fullname_hash, node_info_.id)) {
             info_base_->RemoveSubscribe(*si);
 
-            for (const auto& sess : client_peer_sessions_) {
+            for (const auto& sess : client_peer_sessions) {
                 SPDLOG_LOGGER_DEBUG(LOGGER,
                                     "Sending subscribe withdraw fullname: {} peer_session_id: {}",
                                     si->track_hash.track_fullname_hash,
@@ -638,15 +788,13 @@ namespace laps::peering {
             try {
                 // Update subscription params with new group request
 
-                // subscribe headers in expected order, must each be parsed
-                auto msg_bytes = quicr::BytesSpan(si->subscribe_data);
-                [[maybe_unused]] const auto request_id = quicr::messages::Message::ParseField<std::uint64_t>(msg_bytes);
-                [[maybe_unused]] const auto track_namespace =
-                  quicr::messages::Message::ParseField<quicr::TrackNamespace>(msg_bytes);
-                [[maybe_unused]] const auto track_name = quicr::messages::Message::ParseField<quicr::Bytes>(msg_bytes);
-                auto parameters = quicr::messages::Message::ParseField<quicr::messages::Parameters>(msg_bytes);
+                const auto& sub_view = si->View();
+                const auto request_id = sub_view.request_id;
+                const auto track_namespace = sub_view.track_namespace;
+                const auto track_name = sub_view.track_name;
+                auto parameters = sub_view.parameters;
 
-                auto ngr_id = parameters.GetOptional<uint64_t>(quicr::messages::ParameterType::kNewGroupRequest);
+                auto ngr_id = sub_view.new_group_request_id;
 
                 if (!ngr_id.has_value()) {
                     parameters.AddOptional(quicr::messages::ParameterType::kNewGroupRequest, ngr_id);
@@ -667,8 +815,7 @@ namespace laps::peering {
                                               .Append(track_name)
                                               .Append(parameters);
 
-                            const auto sub_data_bytes = sub_data.ToByteSpan();
-                            si->subscribe_data.assign(sub_data_bytes.begin(), sub_data_bytes.end());
+                            si->SetSubscribeData(sub_data.ToByteSpan());
                         }
                         break;
                     }
@@ -682,7 +829,7 @@ namespace laps::peering {
                                       .Append(track_name)
                                       .Append(parameters);
 
-                    si->subscribe_data.assign(sub_data.ToByteSpan().begin(), sub_data.ToByteSpan().end());
+                    si->SetSubscribeData(sub_data.ToByteSpan());
                 }
 
             } catch (const std::exception& e) {
@@ -691,7 +838,7 @@ namespace laps::peering {
             }
 
             // Existing subscribe, update it with new data and attributes
-            for (const auto& sess : client_peer_sessions_) {
+            for (const auto& sess : ClientPeerSessions()) {
                 SPDLOG_LOGGER_DEBUG(LOGGER,
                                     "Sending subscribe update fullname: {} peer_session_id: {} new_group: {}",
                                     th.track_fullname_hash,
@@ -723,12 +870,26 @@ namespace laps::peering {
         SubscribeInfo si;
 
         si.track_hash = quicr::TrackHash(tfn);
-        si.subscribe_data.assign(subscribe_data.begin(), subscribe_data.end());
+        si.SetSubscribeData(subscribe_data);
         si.source_node_id = node_info_.id;
 
+        // Resubscribe within the unsubscribe hold-down, peers still have the subscribe
+        if (CancelWithdrawSubscribe(si.track_hash.track_fullname_hash)) {
+            const auto existing_si = info_base_->GetSubscribe(si.track_hash.track_fullname_hash, node_info_.id);
+
+            // Any change of the subscribe (e.g., priority or new group request) needs to be advertised. The
+            // request id of a resubscribe is always new and is not used by peers
+            if (existing_si && existing_si->SameSubscribe(si)) {
+                SPDLOG_LOGGER_DEBUG(LOGGER,
+                                    "Canceled subscribe withdraw fullname: {}, subscribe unchanged",
+                                    si.track_hash.track_fullname_hash);
+                return;
+            }
+        }
+
         info_base_->AddSubscribe(si);
 
-        for (const auto& sess : client_peer_sessions_) {
+        for (const auto& sess : ClientPeerSessions()) {
             SPDLOG_LOGGER_DEBUG(LOGGER,
                                 "Sending subscribe fullname: {} peer_session_id: {}",
                                 si.track_hash.track_fullname_hash,
@@ -766,7 +927,7 @@ namespace laps::peering {
             info_base_->RemoveAnnounce(ai);
         }
 
-        for (const auto& sess : client_peer_sessions_) {
+        for (const auto& sess : ClientPeerSessions()) {
             SPDLOG_LOGGER_DEBUG(
               LOGGER,
               "Sending namespace hash: {} name hash: {} full_name_hash: {} to peer_session_id: {} withdraw: {}",
@@ -795,94 +956,69 @@ namespace laps::peering {
         if (not withdraw) {
             uint64_t update_ref = rand();
 
-            // TODO: change to not iterate over all subscribes to find a match
-            for (const auto& [ftn, sub_map] : info_base_->subscribes_) {
-
-                if (sub_map.empty())
-                    continue;
+            for (const auto& sub_info : info_base_->GetPrefixMatchingSubscribes(track_full_name.name_space)) {
+                try {
+                    // Decoded once and cached in the subscribe info
+                    const auto& sub_view = sub_info.View();
+                    const auto& track_namespace = sub_view.track_namespace;
+                    const auto& track_name = sub_view.track_name;
 
-                for (const auto& si_it : sub_map) {
-                    if (si_it.first == node_info_.id)
+                    if (sub_info.source_node_id == node_info_.id)
                         continue;
-                    const auto& sub_info = si_it.second;
 
-                    try {
-                        // subscribe headers in expected order, must each be parsed
-                        auto msg_bytes = quicr::BytesSpan(sub_info.subscribe_data);
-                        [[maybe_unused]] const auto request_id =
-                          quicr::messages::Message::ParseField<std::uint64_t>(msg_bytes);
-                        const auto track_namespace =
-                          quicr::messages::Message::ParseField<quicr::TrackNamespace>(msg_bytes);
-                        [[maybe_unused]] const auto track_name =
-                          quicr::messages::Message::ParseField<quicr::Bytes>(msg_bytes);
-                        auto parameters = quicr::messages::Message::ParseField<quicr::messages::Parameters>(msg_bytes);
+                    if (auto cm = client_manager_) {
+                        quicr::messages::SubscribeAttributes s_attrs;
+                        s_attrs.priority = 10;
 
-                        auto ngr_id =
-                          parameters.GetOptional<uint64_t>(quicr::messages::ParameterType::kNewGroupRequest);
-
-                        if (track_full_name.name_space.HasSamePrefix(track_namespace)) {
-
-                            if (sub_info.source_node_id == node_info_.id)
-                                continue;
+                        if (sub_view.has_new_group_request) {
+                            s_attrs.new_group_request_id = true;
+                        }
 
-                            if (auto cm = client_manager_) {
-                                quicr::messages::SubscribeAttributes s_attrs;
-                                s_attrs.priority = 10;
+                        SPDLOG_LOGGER_INFO(LOGGER,
+                                           "Subscribe to client manager track alias: {}",
+                                           sub_info.track_hash.track_fullname_hash);
 
-                                for (const auto& param : parameters) {
-                                    if (param.type == quicr::messages::ParameterType::kNewGroupRequest) {
-                                        s_attrs.new_group_request_id = true;
-                                        break;
-                                    }
-                                }
+                        cm->ProcessSubscribe(
+                          0, 0, sub_info.track_hash, { track_namespace, track_name }, s_attrs, std::nullopt);
+                    }
 
+                    auto peer_session_weak = info_base_->GetPeerSessionForFlow(
+                      sub_info.source_node_id, sub_info.track_hash.track_fullname_hash);
+                    if (const auto peer_session = peer_session_weak.lock()) {
+                        SPDLOG_LOGGER_DEBUG(LOGGER,
+                                            "Best peer session for subscribe fullname: {} source_node: {} is "
+                                            "via peer_session_id: {}",
+                                            sub_info.track_hash.track_fullname_hash,
+                                            sub_info.source_node_id,
+                                            peer_session->GetSessionId());
+
+                        if (auto [sns_id, is_new] = peer_session->AddSubscribeSourceNode(
+                              sub_info.track_hash.track_fullname_hash,
+                              sub_info.source_node_id,
+                              sub_view.priority);
+                            is_new) {
+                            SPDLOG_LOGGER_INFO(
+                              LOGGER,
+                              "New source added to peer session for subscribe fullname: {} source_node: {} is "
+                              "via peer_session_id: {} sns_id: {}",
+                              sub_info.track_hash.track_fullname_hash,
+                              sub_info.source_node_id,
+                              peer_session->GetSessionId(),
+                              sns_id);
+
+                            if (auto [_, is_new] = info_base_->client_fib_.try_emplace(
+                                  { sub_info.track_hash.track_fullname_hash, peer_session->GetSessionId() },
+                                  InfoBase::FibEntry{ update_ref, {}, sns_id, peer_session_weak });
+                                is_new) {
                                 SPDLOG_LOGGER_INFO(LOGGER,
-                                                   "Subscribe to client manager track alias: {}",
+                                                   "New subscribe fullname: {} added to client fib",
                                                    sub_info.track_hash.track_fullname_hash);
-
-                                cm->ProcessSubscribe(
-                                  0, 0, sub_info.track_hash, { track_namespace, track_name }, s_attrs, std::nullopt);
-                            }
-
-                            auto bp_it = info_base_->nodes_best_.find(sub_info.source_node_id);
-                            if (bp_it != info_base_->nodes_best_.end()) {
-                                const auto& peer_session = bp_it->second.lock();
-                                SPDLOG_LOGGER_DEBUG(LOGGER,
-                                                    "Best peer session for subscribe fullname: {} source_node: {} is "
-                                                    "via peer_session_id: {}",
-                                                    sub_info.track_hash.track_fullname_hash,
-                                                    sub_info.source_node_id,
-                                                    peer_session->GetSessionId());
-
-                                if (auto [sns_id, is_new] = peer_session->AddSubscribeSourceNode(
-                                      sub_info.track_hash.track_fullname_hash,
-                                      sub_info.source_node_id,
-                                      parameters.Get<uint8_t>(quicr::messages::ParameterType::kSubscriberPriority));
-                                    is_new) {
-                                    SPDLOG_LOGGER_INFO(
-                                      LOGGER,
-                                      "New source added to peer session for subscribe fullname: {} source_node: {} is "
-                                      "via peer_session_id: {} sns_id: {}",
-                                      sub_info.track_hash.track_fullname_hash,
-                                      sub_info.source_node_id,
-                                      peer_session->GetSessionId(),
-                                      sns_id);
-
-                                    if (auto [_, is_new] = info_base_->client_fib_.try_emplace(
-                                          { sub_info.track_hash.track_fullname_hash, peer_session->GetSessionId() },
-                                          InfoBase::FibEntry{ update_ref, {}, sns_id, bp_it->second });
-                                        is_new) {
-                                        SPDLOG_LOGGER_INFO(LOGGER,
-                                                           "New subscribe fullname: {} added to client fib",
-                                                           sub_info.track_hash.track_fullname_hash);
-                                    }
-                                }
                             }
                         }
-                    } catch (const std::exception& e) {
-                        SPDLOG_LOGGER_ERROR(LOGGER, "Unable to parse subscribe message {}", e.what());
-                        continue;
                     }
+                } catch (const std::exception& e) {
+                    SPDLOG_LOGGER_ERROR(LOGGER, "Unable to parse subscribe message {}", e.what());
+                    continue;
                 }
             }
         }
@@ -903,6 +1039,12 @@ namespace laps::peering {
 
         check_thr_ = std::thread(&PeerManager::CheckThread, this, cfg.peering.check_interval_ms);
 
+        info_base_->SetMultipath(cfg.peering.multipath_max_paths, cfg.peering.multipath_srtt_margin_us);
+
+        if (cfg.peering.coalesce_window_us) {
+            coalesce_thr_ = std::thread(&PeerManager::CoalesceFlushThread, this);
+        }
+
         node_info_.contact = config_.relay_id_;
         node_info_.id = std::hash<std::string>{}(config_.relay_id_);
         node_info_.type = config_.node_type;
@@ -938,13 +1080,27 @@ namespace laps::peering {
         // Stop threads
         stop_ = true;
 
+        {
+            std::lock_guard _(check_mutex_);
+            check_cv_.notify_all();
+        }
+
+        {
+            std::lock_guard _(coalesce_mutex_);
+            coalesce_cv_.notify_all();
+        }
+
         SPDLOG_LOGGER_INFO(LOGGER, "Closing peer manager threads");
 
+        // Join before clearing sessions, the check thread reconnects sessions
+        if (check_thr_.joinable())
+            check_thr_.join();
+
         client_peer_sessions_.clear();
         server_peer_sessions_.clear();
 
-        if (check_thr_.joinable())
-            check_thr_.join();
+        if (coalesce_thr_.joinable())
+            coalesce_thr_.join();
 
         SPDLOG_LOGGER_INFO(LOGGER, "Closed peer manager stopped");
     }
@@ -955,6 +1111,13 @@ namespace laps::peering {
 
         std::lock_guard _(mutex_);
 
+        // Multipath flow hash; prefer the track so that all SNS for the track follow the same path
+        std::size_t flow_hash = sns.track_fullname_hash;
+        if (!flow_hash) {
+            flow_hash = peer_session.GetSessionId();
+            quicr::hash_combine(flow_hash, sns.id);
+        }
+
         if (withdraw) {
             auto it = info_base_->peer_fib_.find({ peer_session.GetSessionId(), sns.id });
             if (it != info_base_->peer_fib_.end()) {
@@ -969,6 +1132,7 @@ namespace laps::peering {
                 info_base_->peer_fib_.erase(it);
             }
 
+            info_base_->PeerFibChanged(peer_session.GetSessionId(), sns.id, true);
             return;
         }
 
@@ -985,15 +1149,15 @@ namespace laps::peering {
                     continue;
                 }
 
-                auto peer_sess_weak = info_base_->GetBestPeerSession(node_id);
+                auto peer_sess_weak = info_base_->GetPeerSessionForFlow(node_id, flow_hash);
                 if (auto peer_sess = peer_sess_weak.lock()) {
 
-                    const auto [out_sns_id, out_new] =
-                      peer_sess->AddPeerSnsSourceNode(peer_session.GetSessionId(), sns.id, node_id, sns.priority);
+                    const auto [out_sns_id, out_new] = peer_sess->AddPeerSnsSourceNode(
+                      peer_session.GetSessionId(), sns.id, node_id, sns.priority, sns.track_fullname_hash);
 
                     // Update or create fib record
                     fib_it->second[peer_sess->GetSessionId()] =
-                      InfoBase::FibEntry{ update_ref, {}, out_sns_id, peer_sess_weak };
+                      InfoBase::FibEntry{ update_ref, {}, out_sns_id, peer_sess_weak, sns.track_fullname_hash };
                 }
             }
         }
@@ -1009,17 +1173,17 @@ namespace laps::peering {
                     continue;
                 }
 
-                auto peer_sess_weak = info_base_->GetBestPeerSession(node_id);
+                auto peer_sess_weak = info_base_->GetPeerSessionForFlow(node_id, flow_hash);
 
                 if (auto peer_sess = peer_sess_weak.lock()) {
                     auto it = fib_it->second.find(peer_sess->GetSessionId());
                     if (it == fib_it->second.end()) {
                         // New entry
-                        const auto [o_sns_id, __] =
-                          peer_sess->AddPeerSnsSourceNode(peer_session.GetSessionId(), sns.id, node_id, sns.priority);
+                        const auto [o_sns_id, __] = peer_sess->AddPeerSnsSourceNode(
+                          peer_session.GetSessionId(), sns.id, node_id, sns.priority, sns.track_fullname_hash);
 
                         fib_it->second[peer_sess->GetSessionId()] =
-                          InfoBase::FibEntry{ update_ref, {}, o_sns_id, peer_sess_weak };
+                          InfoBase::FibEntry{ update_ref, {}, o_sns_id, peer_sess_weak, sns.track_fullname_hash };
 
                         SPDLOG_LOGGER_DEBUG(LOGGER,
                                             "SNS added peer session: {} sns id: {} added source node_id: {}",
@@ -1029,8 +1193,8 @@ namespace laps::peering {
 
                     } else {
                         // Existing entry
-                        const auto [o_sns_id, is_new] =
-                          peer_sess->AddPeerSnsSourceNode(peer_session.GetSessionId(), sns.id, node_id, sns.priority);
+                        const auto [o_sns_id, is_new] = peer_sess->AddPeerSnsSourceNode(
+                          peer_session.GetSessionId(), sns.id, node_id, sns.priority, sns.track_fullname_hash);
                         if (is_new) {
                             SPDLOG_LOGGER_DEBUG(LOGGER,
                                                 "SNS update peer session: {} sns id: {} added source node_id: {}",
@@ -1040,7 +1204,7 @@ namespace laps::peering {
                         }
 
                         fib_it->second[peer_sess->GetSessionId()] =
-                          InfoBase::FibEntry{ update_ref, {}, o_sns_id, peer_sess_weak };
+                          InfoBase::FibEntry{ update_ref, {}, o_sns_id, peer_sess_weak, sns.track_fullname_hash };
                     }
                 }
             }
@@ -1065,51 +1229,369 @@ namespace laps::peering {
                 fib_it->second.erase(peer_sess_id);
             }
         }
+
+        // Change the version after the update so that cut-through streams resolve the updated egress list
+        info_base_->PeerFibChanged(peer_session.GetSessionId(), sns.id);
     }
 
-    void PeerManager::InfoBaseSyncPeer(PeerSession& peer_session)
+    void PeerManager::InfoBaseSyncPeer(PeerSession& peer_session, const std::optional<SyncState>& request)
     {
         std::lock_guard _(mutex_);
 
-        // Send all node info
-        for (auto [key, node_item] : info_base_->nodes_) {
-            if (key.first == peer_session.node_info_.id || key.second == peer_session.GetSessionId() ||
-                key.first == peer_session.remote_node_info_.id)
-                continue; // Skip, node is self, learned from peer, or peer is the node info
-
-            bool skip{ false };
-            for (auto& npi : node_item.node_info.path) {
-                if (npi.id == peer_session.remote_node_info_.id) {
-                    skip = true;
-                    break; // Skip, remote peer is in path
+        const auto remote_node_id = peer_session.remote_node_info_.id;
+
+        // Connect does not include load, advertise self with current load
+        if (peer_session.PeerVersion() >= kProtocolVersionNodeLoad) {
+            peer_session.SendNodeInfo(SelfNodeInfo());
+        }
+
+        // Peers that support bulk sync get many entries per control message, sent in chunks
+        const bool use_bulk_sync = peer_session.PeerVersion() >= kProtocolVersionBulkSync;
+        BulkSync bulk_sync;
+
+        const auto flush_bulk_sync = [&](bool force) {
+            if (bulk_sync.NumEntries() && (force || bulk_sync.SizeBytes() >= kBulkSyncMaxBytes)) {
+                peer_session.SendBulkSync(bulk_sync);
+                bulk_sync.Clear();
+            }
+        };
+
+        const auto send_node = [&](NodeInfo node_info, bool withdraw) {
+            node_info.path.push_back({ peer_session.node_info_.id, peer_session.metrics_.srtt_us });
+            node_info.with_load = peer_session.PeerVersion() >= kProtocolVersionNodeLoad;
+
+            if (use_bulk_sync) {
+                bulk_sync.Add(withdraw ? MsgType::kNodeInfoWithdrawn : MsgType::kNodeInfoAdvertise, node_info);
+                flush_bulk_sync(false);
+            } else {
+                peer_session.SendNodeInfo(node_info, withdraw);
+            }
+        };
+
+        const auto send_announce = [&](const AnnounceInfo& anno_info, bool withdraw) {
+            if (use_bulk_sync) {
+                bulk_sync.Add(withdraw ? MsgType::kAnnounceInfoWithdrawn : MsgType::kAnnounceInfoAdvertised,
+                              anno_info);
+                flush_bulk_sync(false);
+            } else {
+                peer_session.SendAnnounceInfo(anno_info, withdraw);
+            }
+        };
+
+        const auto send_subscribe = [&](SubscribeInfo& sub_info, bool withdraw) {
+            if (use_bulk_sync) {
+                bulk_sync.Add(withdraw ? MsgType::kSubscribeInfoWithdrawn : MsgType::kSubscribeInfoAdvertised,
+                              sub_info);
+                flush_bulk_sync(false);
+            } else {
+                peer_session.SendSubscribeInfo(sub_info, withdraw);
+            }
+        };
+
+        const auto skip_node = [&](NodeIdValueType node_id, const NodeInfo& node_info) {
+            if (node_id == peer_session.node_info_.id || node_id == remote_node_id)
+                return true; // Skip, node is self or peer is the node info
+
+            for (auto& npi : node_info.path) {
+                if (npi.id == remote_node_id) {
+                    return true; // Skip, remote peer is in path
                 }
             }
 
-            if (skip)
-                continue;
+            return false;
+        };
+
+        /*
+         * Versions are taken before reading the tables. Changes made while the tables are sent
+         * have a greater version and will be sent again if the peer resumes sync from these versions.
+         *
+         * Resumed tables are resolved to the current entries, or withdraws, under the info base lock. The
+         * entries are copied so that they can be sent after the lock is released.
+         */
+        SyncState sync_state;
+
+        // Resumed table entries to send, paired with withdraw
+        std::vector<std::pair<NodeInfo, bool>> node_updates;
+        std::vector<std::pair<AnnounceInfo, bool>> announce_updates;
+        std::vector<std::pair<SubscribeInfo, bool>> subscribe_updates;
+        {
+            std::lock_guard ib_lock(info_base_->mutex_);
+
+            sync_state.epoch = info_base_->sync_epoch_;
+            sync_state.nodes_version = info_base_->nodes_sync_log_.version;
+            sync_state.announces_version = info_base_->announces_sync_log_.version;
+            sync_state.subscribes_version = info_base_->subscribes_sync_log_.version;
+
+            if (request.has_value() && request->epoch == info_base_->sync_epoch_) {
+                if (info_base_->nodes_sync_log_.CanResume(request->nodes_version)) {
+                    sync_state.flags |= kSyncFlagNodesResumed;
+
+                    // Latest change by node id, current node info is sent if still present, otherwise withdrawn
+                    std::map<NodeIdValueType, NodeInfo> changed;
+                    for (auto& change : info_base_->nodes_sync_log_.ChangesSince(request->nodes_version)) {
+                        changed[change.info.id] = std::move(change.info);
+                    }
+
+                    for (auto& [node_id, changed_info] : changed) {
+                        const NodeInfo* current{ nullptr };
+                        for (auto it = info_base_->nodes_.lower_bound({ node_id, 0 });
+                             it != info_base_->nodes_.end() && it->first.first == node_id;
+                             ++it) {
+                            if (it->first.second != peer_session.GetSessionId() &&
+                                !skip_node(node_id, it->second.node_info)) {
+                                current = &it->second.node_info;
+                            }
+                        }
+
+                        if (current != nullptr) {
+                            node_updates.emplace_back(*current, false);
+                        } else if (!skip_node(node_id, changed_info)) {
+                            node_updates.emplace_back(std::move(changed_info), true);
+                        }
+                    }
+                }
+
+                if (info_base_->announces_sync_log_.CanResume(request->announces_version)) {
+                    sync_state.flags |= kSyncFlagAnnouncesResumed;
+
+                    std::map<std::pair<quicr::TrackFullNameHash, NodeIdValueType>, AnnounceInfo> changed;
+                    for (auto& change : info_base_->announces_sync_log_.ChangesSince(request->announces_version)) {
+                        changed[{ change.info.fullname_hash, change.info.source_node_id }] = std::move(change.info);
+                    }
+
+                    for (auto& [key, changed_info] : changed) {
+                        if (remote_node_id == key.second)
+                            continue; // Skip, don't send self or remote to self
+
+                        const auto anno_it = info_base_->announces_.find(key.first);
+                        if (anno_it != info_base_->announces_.end()) {
+                            if (const auto it = anno_it->second.find(key.second); it != anno_it->second.end()) {
+                                announce_updates.emplace_back(it->second, false);
+                                continue;
+                            }
+                        }
 
-            node_item.node_info.path.push_back({ peer_session.node_info_.id, peer_session.metrics_.srtt_us });
-            peer_session.SendNodeInfo(node_item.node_info);
+                        announce_updates.emplace_back(std::move(changed_info), true);
+                    }
+                }
+
+                if (info_base_->subscribes_sync_log_.CanResume(request->subscribes_version)) {
+                    sync_state.flags |= kSyncFlagSubscribesResumed;
+
+                    std::map<std::pair<quicr::TrackFullNameHash, NodeIdValueType>, SubscribeInfo> changed;
+                    for (auto& change : info_base_->subscribes_sync_log_.ChangesSince(request->subscribes_version)) {
+                        changed[{ change.info.track_hash.track_fullname_hash, change.info.source_node_id }] =
+                          std::move(change.info);
+                    }
+
+                    for (auto& [key, changed_info] : changed) {
+                        if (remote_node_id == key.second)
+                            continue; // Skip, don't send self or remote to self
+
+                        const auto sub_it = info_base_->subscribes_.find(key.first);
+                        if (sub_it != info_base_->subscribes_.end()) {
+                            if (const auto it = sub_it->second.find(key.second); it != sub_it->second.end()) {
+                                subscribe_updates.emplace_back(it->second, false);
+                                continue;
+                            }
+                        }
+
+                        subscribe_updates.emplace_back(std::move(changed_info), true);
+                    }
+                }
+            }
         }
 
-        for (const auto& [th, anno_item] : info_base_->announces_) {
-            for (const auto& [_, anno_info] : anno_item) {
-                if (peer_session.remote_node_info_.id == anno_info.source_node_id)
-                    continue; // Skip, don't send self or remote to self
+        if (request.has_value()) {
+            SPDLOG_LOGGER_INFO(LOGGER,
+                               "Sync peer session: {} resume flags: {} node updates: {} announce updates: {} "
+                               "subscribe updates: {}",
+                               peer_session.GetSessionId(),
+                               sync_state.flags,
+                               node_updates.size(),
+                               announce_updates.size(),
+                               subscribe_updates.size());
+
+            peer_session.SendSyncState(sync_state);
+        }
 
-                peer_session.SendAnnounceInfo(anno_info);
+        // Send node info
+        if (sync_state.flags & kSyncFlagNodesResumed) {
+            for (const auto& [node_info, withdraw] : node_updates) {
+                send_node(node_info, withdraw);
+            }
+        } else {
+            for (const auto& [key, node_item] : info_base_->nodes_) {
+                if (key.second == peer_session.GetSessionId() || skip_node(key.first, node_item.node_info))
+                    continue; // Skip, node is self, learned from peer, or peer is the node info
+
+                send_node(node_item.node_info, false);
             }
         }
 
-        // Send all subscribes
-        for (auto& [tfh, sub_item] : info_base_->subscribes_) {
-            for (auto& [_, sub_info] : sub_item) {
-                if (peer_session.remote_node_info_.id == sub_info.source_node_id)
-                    continue; // Skip, don't send self or remote to self
+        // Send announces
+        if (sync_state.flags & kSyncFlagAnnouncesResumed) {
+            for (const auto& [anno_info, withdraw] : announce_updates) {
+                send_announce(anno_info, withdraw);
+            }
+        } else {
+            for (const auto& [th, anno_item] : info_base_->announces_) {
+                for (const auto& [_, anno_info] : anno_item) {
+                    if (remote_node_id == anno_info.source_node_id)
+                        continue; // Skip, don't send self or remote to self
 
-                peer_session.SendSubscribeInfo(sub_info);
+                    send_announce(anno_info, false);
+                }
             }
         }
+
+        // Send subscribes
+        if (sync_state.flags & kSyncFlagSubscribesResumed) {
+            for (auto& [sub_info, withdraw] : subscribe_updates) {
+                send_subscribe(sub_info, withdraw);
+            }
+        } else {
+            for (auto& [tfh, sub_item] : info_base_->subscribes_) {
+                for (auto& [_, sub_info] : sub_item) {
+                    if (remote_node_id == sub_info.source_node_id)
+                        continue; // Skip, don't send self or remote to self
+
+                    send_subscribe(sub_info, false);
+                }
+            }
+        }
+
+        flush_bulk_sync(true);
+
+        if (request.has_value()) {
+            sync_state.flags |= kSyncFlagDone;
+            peer_session.SendSyncState(sync_state);
+        }
+    }
+
+    SyncState PeerManager::GetSyncRequest(NodeIdValueType remote_node_id)
+    {
+        std::lock_guard _(sync_cache_mutex_);
+
+        SyncState request;
+
+        if (const auto it = peer_sync_cache_.find(remote_node_id); it != peer_sync_cache_.end()) {
+            request = it->second.state;
+            request.flags = 0;
+        }
+
+        return request;
+    }
+
+    void PeerManager::SyncStateReceived(PeerSession& peer_session, const SyncState& sync_state)
+    {
+        std::vector<NodeInfo> nodes;
+        std::vector<AnnounceInfo> announces;
+        std::vector<SubscribeInfo> subscribes;
+
+        {
+            std::lock_guard _(sync_cache_mutex_);
+            auto& cache = peer_sync_cache_[peer_session.remote_node_info_.id];
+
+            if (sync_state.flags & kSyncFlagDone) {
+                cache.state = sync_state;
+
+                SPDLOG_LOGGER_INFO(LOGGER,
+                                   "Sync done peer session: {} nodes: {} announces: {} subscribes: {}",
+                                   peer_session.GetSessionId(),
+                                   cache.nodes.size(),
+                                   cache.announces.size(),
+                                   cache.subscribes.size());
+                return;
+            }
+
+            // Versions are only valid once the sync is done
+            cache.state = {};
+
+            // Resumed tables replay what was received from the previous session, others are sent in full
+            if (sync_state.flags & kSyncFlagNodesResumed) {
+                for (const auto& [_, node_info] : cache.nodes) {
+                    nodes.push_back(node_info);
+                }
+            } else {
+                cache.nodes.clear();
+            }
+
+            if (sync_state.flags & kSyncFlagAnnouncesResumed) {
+                for (const auto& [_, anno_info] : cache.announces) {
+                    announces.push_back(anno_info);
+                }
+            } else {
+                cache.announces.clear();
+            }
+
+            if (sync_state.flags & kSyncFlagSubscribesResumed) {
+                for (const auto& [_, sub_info] : cache.subscribes) {
+                    subscribes.push_back(sub_info);
+                }
+            } else {
+                cache.subscribes.clear();
+            }
+        }
+
+        SPDLOG_LOGGER_INFO(LOGGER,
+                           "Sync resume peer session: {} flags: {} replay nodes: {} announces: {} subscribes: {}",
+                           peer_session.GetSessionId(),
+                           sync_state.flags,
+                           nodes.size(),
+                           announces.size(),
+                           subscribes.size());
+
+        for (const auto& node_info : nodes) {
+            NodeReceived(peer_session.GetSessionId(), node_info, false);
+        }
+
+        for (const auto& anno_info : announces) {
+            AnnounceInfoReceived(peer_session.GetSessionId(), anno_info, false);
+        }
+
+        for (auto& sub_info : subscribes) {
+            SubscribeInfoReceived(peer_session.GetSessionId(), sub_info, false);
+        }
+    }
+
+    void PeerManager::RecordSyncEntry(NodeIdValueType remote_node_id, const NodeInfo& node_info, bool withdraw)
+    {
+        std::lock_guard _(sync_cache_mutex_);
+        auto& cache = peer_sync_cache_[remote_node_id];
+
+        if (withdraw) {
+            cache.nodes.erase(node_info.id);
+        } else {
+            cache.nodes[node_info.id] = node_info;
+        }
+    }
+
+    void PeerManager::RecordSyncEntry(NodeIdValueType remote_node_id, const AnnounceInfo& announce_info, bool withdraw)
+    {
+        std::lock_guard _(sync_cache_mutex_);
+        auto& cache = peer_sync_cache_[remote_node_id];
+
+        if (withdraw) {
+            cache.announces.erase({ announce_info.fullname_hash, announce_info.source_node_id });
+        } else {
+            cache.announces[{ announce_info.fullname_hash, announce_info.source_node_id }] = announce_info;
+        }
+    }
+
+    void PeerManager::RecordSyncEntry(NodeIdValueType remote_node_id,
+                                      const SubscribeInfo& subscribe_info,
+                                      bool withdraw)
+    {
+        std::lock_guard _(sync_cache_mutex_);
+        auto& cache = peer_sync_cache_[remote_node_id];
+
+        const std::pair key{ subscribe_info.track_hash.track_fullname_hash, subscribe_info.source_node_id };
+        if (withdraw) {
+            cache.subscribes.erase(key);
+        } else {
+            cache.subscribes[key] = subscribe_info;
+        }
     }
 
     void PeerManager::PropagateNodeInfo(PeerSessionId peer_session_id, const NodeInfo& node_info, bool withdraw)
@@ -1187,6 +1669,8 @@ namespace laps::peering {
             return s_peer_it->second;
         }
 
+        std::lock_guard _(mutex_);
+
         auto c_peer_it = client_peer_sessions_.find(peer_session_id);
         if (c_peer_it != client_peer_sessions_.end()) {
             return c_peer_it->second;
@@ -1195,14 +1679,187 @@ namespace laps::peering {
         throw std::invalid_argument("Peer session id does not exist");
     }
 
+    PeerManager::PeerSessionList PeerManager::ClientPeerSessions()
+    {
+        std::lock_guard _(mutex_);
+        return { client_peer_sessions_.begin(), client_peer_sessions_.end() };
+    }
+
     void PeerManager::CreatePeerSession(const quicr::TransportRemote& peer_config)
     {
         auto peer_sess = std::make_shared<PeerSession>(false, 0, config_, node_info_, peer_config, *this);
         peer_sess->Connect();
 
+        if (config_.peering.coalesce_window_us) {
+            std::lock_guard _(coalesce_mutex_);
+            coalesce_sessions_.push_back(peer_sess);
+        }
+
+        std::lock_guard _(mutex_);
         client_peer_sessions_.try_emplace(peer_sess->GetSessionId(), std::move(peer_sess));
     }
 
+    uint64_t PeerManager::CurrentTickMs() const
+    {
+        return static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::milliseconds>(tick_service_->get()).count());
+    }
+
+    uint64_t PeerManager::CurrentTickUs() const
+    {
+        return static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(tick_service_->get()).count());
+    }
+
+    NodeInfo PeerManager::SelfNodeInfo()
+    {
+        auto node_info = node_info_;
+
+        std::lock_guard _(check_mutex_);
+        node_info.load = node_load_;
+
+        return node_info;
+    }
+
+    void PeerManager::RefreshNodeLoad()
+    {
+        NodeLoad load;
+
+        // Process CPU time over the interval, relative to all cores
+        const auto cpu_clock = std::clock();
+        const auto now_ms = CurrentTickMs();
+        if (load_sample_ms_ && now_ms > load_sample_ms_ && cpu_clock >= load_cpu_clock_) {
+            const double cpu_ms = 1000.0 * static_cast<double>(cpu_clock - load_cpu_clock_) / CLOCKS_PER_SEC;
+            const double cores = std::max(1U, std::thread::hardware_concurrency());
+            load.cpu_pct = static_cast<uint8_t>(
+              std::clamp(100.0 * cpu_ms / (static_cast<double>(now_ms - load_sample_ms_) * cores), 0.0, 100.0));
+        }
+        load_cpu_clock_ = cpu_clock;
+        load_sample_ms_ = now_ms;
+
+        uint64_t egress_bps = client_manager_ != nullptr ? client_manager_->EgressRateBps() : 0;
+        {
+            std::lock_guard _(mutex_);
+            for (const auto& [id, peer_sess] : client_peer_sessions_) {
+                egress_bps += peer_sess->metrics_.tx_rate_bps;
+            }
+            for (const auto& [id, peer_sess] : server_peer_sessions_) {
+                egress_bps += peer_sess->metrics_.tx_rate_bps;
+            }
+        }
+        load.egress_kbps = static_cast<uint32_t>(std::min<uint64_t>(egress_bps / 1000, UINT32_MAX));
+
+        {
+            std::lock_guard _(info_base_->mutex_);
+            load.active_tracks = static_cast<uint32_t>(info_base_->client_fib_.size() + info_base_->peer_fib_.size());
+        }
+
+        {
+            std::lock_guard _(check_mutex_);
+
+            // Only advertise changes that affect selection to avoid node info churn
+            const auto cpu_change = std::abs(static_cast<int>(load.cpu_pct) - static_cast<int>(node_load_.cpu_pct));
+            const bool advertise =
+              load.Overloaded() != node_load_.Overloaded() || cpu_change >= kNodeLoadAdvertiseCpuChangePct;
+
+            if (!advertise) {
+                return;
+            }
+
+            node_load_ = load;
+        }
+
+        SPDLOG_LOGGER_DEBUG(LOGGER,
+                            "Advertising node load cpu: {}% egress: {} Kbps active tracks: {}",
+                            load.cpu_pct,
+                            load.egress_kbps,
+                            load.active_tracks);
+
+        PropagateNodeInfo(SelfNodeInfo());
+    }
+
+    std::string PeerManager::ReconnectKey(PeerSessionId peer_session_id)
+    {
+        std::lock_guard _(mutex_);
+
+        auto it = client_peer_sessions_.find(peer_session_id);
+        if (it == client_peer_sessions_.end()) {
+            return {};
+        }
+
+        return it->second->peer_config_.host_or_ip + ":" + std::to_string(it->second->peer_config_.port);
+    }
+
+    void PeerManager::ScheduleReconnect(PeerSessionId peer_session_id)
+    {
+        const auto key = ReconnectKey(peer_session_id);
+        if (key.empty() || stop_) {
+            return;
+        }
+
+        std::lock_guard _(check_mutex_);
+
+        if (!reconnect_pending_.emplace(peer_session_id).second) {
+            return; // Already scheduled
+        }
+
+        auto& attempts = reconnect_attempts_[key];
+
+        const uint64_t backoff_ms = std::min<uint64_t>(config_.peering.reconnect_max_ms,
+                                                       static_cast<uint64_t>(config_.peering.reconnect_min_ms)
+                                                         << std::min<uint32_t>(attempts, 16));
+        std::uniform_int_distribution<uint64_t> jitter(backoff_ms / 2, backoff_ms);
+        const auto delay_ms = jitter(reconnect_rand_);
+
+        attempts++;
+
+        reconnect_timers_.emplace(CurrentTickMs() + delay_ms, peer_session_id);
+
+        SPDLOG_LOGGER_INFO(LOGGER,
+                           "Peer session {} to {} disconnected, reconnect attempt {} in {} ms",
+                           peer_session_id,
+                           key,
+                           attempts,
+                           delay_ms);
+
+        check_cv_.notify_one();
+    }
+
+    void PeerManager::Reconnect(PeerSessionId peer_session_id)
+    {
+        std::shared_ptr<PeerSession> peer_sess;
+
+        {
+            std::lock_guard _(mutex_);
+
+            auto it = client_peer_sessions_.find(peer_session_id);
+            if (it == client_peer_sessions_.end() || it->second->Status() != PeerSession::StatusValue::kDisconnected) {
+                return;
+            }
+
+            peer_sess = std::move(it->second);
+            client_peer_sessions_.erase(it);
+        }
+
+        SPDLOG_LOGGER_INFO(LOGGER, "Peer session {} disconnected, reconnecting", peer_session_id);
+
+        // Connect is not called with the lock held as transport callbacks may need the lock
+        peer_sess->Connect();
+
+        const auto new_peer_session_id = peer_sess->GetSessionId(); // New connect has new session ID
+        const bool disconnected = peer_sess->Status() == PeerSession::StatusValue::kDisconnected;
+
+        {
+            std::lock_guard _(mutex_);
+            client_peer_sessions_.try_emplace(new_peer_session_id, std::move(peer_sess));
+        }
+
+        // Disconnect may have happened before the session was indexed by the new session ID
+        if (disconnected) {
+            ScheduleReconnect(new_peer_session_id);
+        }
+    }
+
     void PeerManager::CheckThread(int interval_ms)
     {
         SPDLOG_LOGGER_INFO(LOGGER, "Running peer manager outbound peer connection thread");
@@ -1210,32 +1867,134 @@ namespace laps::peering {
         if (interval_ms < 2000)
             interval_ms = 2000;
 
-        auto start = std::chrono::system_clock::now();
+        auto next_check_ms = CurrentTickMs() + interval_ms;
+
+        std::unique_lock lock(check_mutex_);
 
         while (not stop_) {
-            auto check = std::chrono::system_clock::now();
-
-            // Run check only after interval ms
-            if (std::chrono::duration_cast<std::chrono::milliseconds>(check - start).count() >= interval_ms) {
-                start = std::chrono::system_clock::now();
-
-                std::vector<PeerSessionId> remove_peer_sess;
-                for (auto& [id, sess] : client_peer_sessions_) {
-                    if (sess->Status() == PeerSession::StatusValue::kDisconnected) {
-                        SPDLOG_LOGGER_INFO(LOGGER, "Peer session {} disconnected, reconnecting", sess->GetSessionId());
-                        sess->Connect();
-                        client_peer_sessions_.try_emplace(sess->GetSessionId(), std::move(sess));
-                        remove_peer_sess.push_back(id); // New connect has new session ID, remove old
+            const auto now_ms = CurrentTickMs();
+
+            auto wake_ms = next_check_ms;
+            if (!reconnect_timers_.empty()) {
+                wake_ms = std::min(wake_ms, reconnect_timers_.begin()->first);
+            }
+            if (!unsubscribe_timers_.empty()) {
+                wake_ms = std::min(wake_ms, unsubscribe_timers_.begin()->first);
+            }
+
+            if (wake_ms > now_ms) {
+                // Woken early when a reconnect or withdraw is scheduled or the manager is stopped
+                check_cv_.wait_for(lock, std::chrono::milliseconds(wake_ms - now_ms));
+                continue;
+            }
+
+            // Peer sessions are needed to withdraw, snapshot them without check_mutex_ held (lock order)
+            PeerSessionList client_peer_sessions;
+            if (!unsubscribe_timers_.empty() && unsubscribe_timers_.begin()->first <= now_ms) {
+                lock.unlock();
+                client_peer_sessions = ClientPeerSessions();
+                lock.lock();
+            }
+
+            std::vector<PeerSessionId> due_peer_sess;
+            while (!reconnect_timers_.empty() && reconnect_timers_.begin()->first <= now_ms) {
+                const auto peer_session_id = reconnect_timers_.begin()->second;
+                reconnect_timers_.erase(reconnect_timers_.begin());
+                reconnect_pending_.erase(peer_session_id);
+                due_peer_sess.push_back(peer_session_id);
+            }
+
+            // Withdraw with the lock held so that a resubscribe is advertised after the withdraw
+            while (!unsubscribe_timers_.empty() && unsubscribe_timers_.begin()->first <= now_ms) {
+                const auto track_fullname_hash = unsubscribe_timers_.begin()->second;
+                unsubscribe_timers_.erase(unsubscribe_timers_.begin());
+                unsubscribe_pending_.erase(track_fullname_hash);
+
+                SPDLOG_LOGGER_DEBUG(LOGGER, "Subscribe withdraw hold-down expired fullname: {}", track_fullname_hash);
+                WithdrawSubscribe(track_fullname_hash, client_peer_sessions);
+            }
+
+            const bool run_check = now_ms >= next_check_ms;
+            if (run_check) {
+                next_check_ms = now_ms + interval_ms;
+            }
+
+            lock.unlock();
+
+            for (const auto peer_session_id : due_peer_sess) {
+                Reconnect(peer_session_id);
+            }
+
+            if (run_check) {
+                RefreshNodeLoad();
+
+                // Check for disconnected sessions that were not scheduled, such as a failed connect
+                std::vector<PeerSessionId> disconnected_peer_sess;
+                {
+                    std::lock_guard _(mutex_);
+                    for (const auto& [id, sess] : client_peer_sessions_) {
+                        if (sess->Status() == PeerSession::StatusValue::kDisconnected) {
+                            disconnected_peer_sess.push_back(id);
+                        }
                     }
                 }
 
-                for (const auto id : remove_peer_sess) {
-                    client_peer_sessions_.erase(id);
+                for (const auto peer_session_id : disconnected_peer_sess) {
+                    ScheduleReconnect(peer_session_id);
+                }
+            }
+
+            lock.lock();
+        }
+    }
+
+    void PeerManager::CoalesceFlushThread()
+    {
+        SPDLOG_LOGGER_INFO(
+          LOGGER, "Running peer manager coalesce flush thread, window: {} us", config_.peering.coalesce_window_us);
+
+        constexpr auto kNoneDue = std::numeric_limits<uint64_t>::max();
+
+        std::unique_lock lock(coalesce_mutex_);
+
+        while (not stop_) {
+            auto next_flush_tick_us = kNoneDue;
+
+            std::erase_if(coalesce_sessions_, [&next_flush_tick_us](const auto& sess_weak) {
+                if (auto sess = sess_weak.lock()) {
+                    if (const auto flush_tick_us = sess->FlushCoalescedData()) {
+                        next_flush_tick_us = std::min(next_flush_tick_us, *flush_tick_us);
+                    }
+                    return false;
                 }
+
+                return true; // Peer session no longer exists
+            });
+
+            coalesce_wake_tick_us_ = next_flush_tick_us;
+
+            // Woken early when data is pending that is due before the next flush or the manager is stopped
+            const auto woken = [&] { return stop_ || coalesce_wake_tick_us_ < next_flush_tick_us; };
+
+            if (next_flush_tick_us == kNoneDue) {
+                coalesce_cv_.wait(lock, woken);
+                continue;
             }
 
-            // Sleep shorter so that the loop can be stopped within this time instead of a larger interval
-            std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms / 2));
+            const auto now_us = CurrentTickUs();
+            if (next_flush_tick_us > now_us) {
+                coalesce_cv_.wait_for(lock, std::chrono::microseconds(next_flush_tick_us - now_us), woken);
+            }
+        }
+    }
+
+    void PeerManager::CoalesceScheduled(uint64_t flush_tick_us)
+    {
+        std::lock_guard _(coalesce_mutex_);
+
+        if (flush_tick_us < coalesce_wake_tick_us_) {
+            coalesce_wake_tick_us_ = flush_tick_us;
+            coalesce_cv_.notify_one();
         }
     }
 
@@ -1309,6 +2068,11 @@ namespace laps::peering {
 
             peer_sess->SetTransport(server_transport_);
             peer_sess->Connect();
+
+            if (config_.peering.coalesce_window_us) {
+                std::lock_guard _(coalesce_mutex_);
+                coalesce_sessions_.push_back(peer_sess);
+            }
         }
     }
 
@@ -1380,13 +2144,8 @@ namespace laps::peering {
             }
 
             if (auto out_peer_sess = entry.peer_session.lock()) {
-                for (const auto& [in_stream_id, out_stream_id] : entry.streams) {
-                    if (out_stream_id == stream_id) {
-                        entry.streams.erase(out_stream_id);
-                        client_manager_->PeerStreamClosed(
-                          key.first, stream_id, flag == quicr::StreamClosedFlag::kReset);
-                        break;
-                    }
+                if (entry.EraseClientStreamById(stream_id)) {
+                    client_manager_->PeerStreamClosed(key.first, stream_id, flag == quicr::StreamClosedFlag::kReset);
                 }
             }
         }
@@ -2,9 +2,12 @@
 // SPDX-License-Identifier: BSD-2-Clause
 #pragma once
 
+#include <condition_variable>
+#include <ctime>
 #include <map>
 #include <quicr/detail/quic_transport.h>
 #include <quicr/detail/safe_queue.h>
+#include <random>
 #include <thread>
 
 #include "config.h"
@@ -49,7 +52,27 @@ namespace laps::peering {
                              uint64_t data_offset,
                              quicr::ITransport::EnqueueFlags eflags);
 
+        /**
+         * @brief Resolve the egress peer streams for a cut-through data stream
+         *
+         * @details Via relays forward peer data streams without inspecting each chunk. The peer FIB
+         *      is looked up once and the egress streams are created (start of stream) or found (existing)
+         *      and stored in the stream context egress list.
+         *
+         * @param peer_session_id       Ingress peer session ID
+         * @param stream_id             Ingress stream ID
+         * @param is_new_stream         True if start of stream, egress streams will be created
+         * @param stream_ctx            Stream context with data header, egress list is updated
+         *
+         * @returns True if the stream can be forwarded cut-through, False if ForwardPeerData must be used
+         */
+        bool ResolveStreamEgress(PeerSessionId peer_session_id,
+                                 uint64_t stream_id,
+                                 bool is_new_stream,
+                                 DataStreamContext& stream_ctx);
+
         void ClientDataRecv(quicr::TrackFullNameHash track_full_name_hash,
+                            quicr::ConnectionHandle connection_handle,
                             uint8_t priority,
                             uint32_t ttl,
                             DataType type,
@@ -74,6 +97,15 @@ namespace laps::peering {
                              const quicr::messages::SubscribeAttributes&,
                              std::span<const uint8_t> subscribe_data);
 
+        /**
+         * @brief Withdraw the local subscribe of a track from peers
+         *
+         * @details When the unsubscribe hold-down is configured, the withdraw is scheduled after the
+         *      hold-down and is canceled if the track is subscribed again before then. This contains
+         *      client unsubscribe/subscribe churn to this relay instead of rippling over the relay network.
+         *
+         * @param track_fullname_hash   Track full name hash of the subscribe to withdraw
+         */
         void ClientUnsubscribe(uint64_t track_fullname_hash);
 
         void SetClientManager(std::shared_ptr<ClientManager> client_manager)
@@ -128,7 +160,42 @@ namespace laps::peering {
 
         bool HasSubscribers(uint64_t track_fullname_hash);
 
-        void InfoBaseSyncPeer(PeerSession& peer_session);
+        /**
+         * @brief Sync the information base to a peer
+         *
+         * @details Sends node, announce and subscribe info to the peer. When the peer sends a sync request
+         *      with the epoch and versions of its last completed sync, only the changes since those versions
+         *      are sent for each table that can be resumed. Other tables are sent in full.
+         *
+         * @param peer_session      Peer session to sync
+         * @param request           Sync request from the peer, nullopt to send in full without sync state
+         */
+        void InfoBaseSyncPeer(PeerSession& peer_session, const std::optional<SyncState>& request = std::nullopt);
+
+        /**
+         * @brief Get the sync request to send to a peer
+         *
+         * @param remote_node_id    Node id of the peer
+         *
+         * @returns Epoch and versions of the last completed sync from the peer, epoch is zero if none
+         */
+        SyncState GetSyncRequest(NodeIdValueType remote_node_id);
+
+        /**
+         * @brief Sync state received from a peer
+         *
+         * @details At the start of a sync, info received from the previous session is replayed for
+         *      resumed tables and discarded for tables that are sent in full. When the sync is done,
+         *      the versions are saved to resume sync when the peer reconnects.
+         */
+        void SyncStateReceived(PeerSession& peer_session, const SyncState& sync_state);
+
+        /**
+         * @brief Record info received from a peer, used to resume sync after the peer reconnects
+         */
+        void RecordSyncEntry(NodeIdValueType remote_node_id, const NodeInfo& node_info, bool withdraw);
+        void RecordSyncEntry(NodeIdValueType remote_node_id, const AnnounceInfo& announce_info, bool withdraw);
+        void RecordSyncEntry(NodeIdValueType remote_node_id, const SubscribeInfo& subscribe_info, bool withdraw);
 
         void SnsReceived(PeerSession& peer_session, const SubscribeNodeSet& sns, bool withdraw = false);
 
@@ -146,11 +213,13 @@ namespace laps::peering {
          *      been delivered.
          *
          * @param track_full_name_hash  Track full name hash (aka track alias)
+         * @param connection_handle     Client connection handle that published the subgroup
          * @param group_id              Group ID of the subgroup
          * @param subgroup_id           Subgroup Id to close
          * @param reset                 Use reset to close the stream, if false use fin
          */
         void EndSubgroup(quicr::TrackFullNameHash track_full_name_hash,
+                         quicr::ConnectionHandle connection_handle,
                          uint64_t group_id,
                          uint64_t subgroup_id,
                          bool reset = false);
@@ -180,12 +249,108 @@ namespace laps::peering {
       private:
         /**
          * @brief Check Thread to perform reconnects and cleanup
-         * @details Thread will perform various tasks each interval
+         * @details Thread sleeps until the next scheduled reconnect or subscribe withdraw is due or a new one
+         *      is scheduled. Outbound peer sessions are scheduled for reconnect on disconnect. Each interval the
+         *      outbound peer sessions are also checked for disconnects that were not scheduled.
          *
-         * @param interval_ms       Interval in milliseconds to sleep before running check
+         * @param interval_ms       Interval in milliseconds to check for disconnected peer sessions
          */
         void CheckThread(int interval_ms);
 
+        /**
+         * @brief Schedule reconnect of a disconnected outbound peer session
+         *
+         * @details Reconnect is delayed by an exponential backoff per peer, starting at the configured
+         *      minimum and doubling on each attempt up to the configured maximum. The delay is jittered
+         *      between half and the full backoff so that peers do not reconnect in lock step. Backoff is
+         *      reset when the peer session is connected.
+         *
+         * @param peer_session_id       Peer session id of the outbound peer session
+         */
+        void ScheduleReconnect(PeerSessionId peer_session_id);
+
+        /**
+         * @brief Reconnect outbound peer session if it's disconnected
+         * @details The session is indexed by the new peer session id after reconnect
+         */
+        void Reconnect(PeerSessionId peer_session_id);
+
+        /**
+         * @brief Get the reconnect backoff key of an outbound peer session
+         *
+         * @returns Peer host and port, empty if the peer session id is not an outbound peer session
+         */
+        std::string ReconnectKey(PeerSessionId peer_session_id);
+
+        using PeerSessionList = std::vector<std::pair<PeerSessionId, std::shared_ptr<PeerSession>>>;
+
+        /**
+         * @brief Snapshot of the client (outbound) peer sessions
+         * @details Client peer sessions are replaced by the check thread on reconnect. Readers iterate the
+         *      snapshot that is taken with mutex_ held. MUST NOT be called with mutex_ or check_mutex_ held.
+         */
+        PeerSessionList ClientPeerSessions();
+
+        /**
+         * @brief Withdraw the local subscribe of a track from peers now
+         *
+         * @param track_fullname_hash   Track full name hash of the subscribe
+         * @param client_peer_sessions  Snapshot of the client peer sessions. Callers that hold check_mutex_
+         *                              take the snapshot before acquiring it to respect the lock order
+         */
+        void WithdrawSubscribe(uint64_t track_fullname_hash, const PeerSessionList& client_peer_sessions);
+
+        /**
+         * @brief Cancel a scheduled subscribe withdraw
+         *
+         * @returns True if a withdraw was scheduled and canceled, false otherwise
+         */
+        bool CancelWithdrawSubscribe(uint64_t track_fullname_hash);
+
+        /**
+         * @brief Move or remove the subscribes of nodes that have a best or equal cost path change
+         * @details Subscribes are moved when the peer session of their client FIB entry is no longer a path
+         *      to the node, or when their flow hashes to another equal cost peer session. Subscribes of a node
+         *      that is no longer reachable are removed. Subscribes are only moved when they have a client FIB
+         *      entry via the previous best peer session. MUST NOT be called with the info base mutex held.
+         *
+         * @param changes           Path changes returned by the info base update
+         * @param skip_node_id      Node id to skip, its subscribes are handled by the caller
+         */
+        void ApplyBestPathChanges(const std::vector<InfoBase::BestPathChange>& changes,
+                                  std::optional<NodeIdValueType> skip_node_id = std::nullopt);
+
+        uint64_t CurrentTickMs() const;
+        uint64_t CurrentTickUs() const;
+
+        /**
+         * @brief Get self node info with the current load
+         */
+        NodeInfo SelfNodeInfo();
+
+        /**
+         * @brief Refresh self node load from the relay counters
+         * @details Called by the check thread every interval. Node info is advertised to peers when the
+         *      load changes enough to affect their selection.
+         */
+        void RefreshNodeLoad();
+
+        /**
+         * @brief Coalesce flush thread to enqueue coalesced peer stream data
+         * @details Thread is only started when peer stream data coalescing is enabled. The thread waits
+         *      until the earliest pending data is due, or until woken by CoalesceScheduled.
+         */
+        void CoalesceFlushThread();
+
+        /**
+         * @brief Wake the coalesce flush thread if pending data is due before its next flush
+         * @details Called by peer sessions when new pending coalesced data is added. MUST NOT be called
+         *      with the peer session coalesce lock held.
+         *
+         * @param flush_tick_us     Tick in microseconds when the pending data is due
+         */
+        void CoalesceScheduled(uint64_t flush_tick_us);
+
         /**
          * @brief Create a peering session/connection
          *
@@ -218,6 +383,40 @@ namespace laps::peering {
 
         std::thread check_thr_; /// Check/task thread, handles reconnects
 
+        std::mutex check_mutex_;
+        std::condition_variable check_cv_; /// Signals check thread that a reconnect or withdraw is scheduled
+        std::multimap<uint64_t, PeerSessionId> reconnect_timers_; /// Reconnect due tick in ms to peer session id
+        std::set<PeerSessionId> reconnect_pending_;               /// Peer sessions that have a reconnect scheduled
+        std::map<std::string, uint32_t> reconnect_attempts_;      /// Reconnect attempts by peer host and port
+        std::mt19937 reconnect_rand_{ std::random_device{}() };   /// Reconnect backoff jitter
+
+        NodeLoad node_load_;               /// Last advertised self node load, guarded by check_mutex_
+        std::clock_t load_cpu_clock_{ 0 }; /// Process CPU clock of the last load refresh
+        uint64_t load_sample_ms_{ 0 };     /// Tick in ms of the last load refresh
+
+        std::multimap<uint64_t, uint64_t> unsubscribe_timers_; /// Withdraw due tick in ms to track full name hash
+        std::map<uint64_t, uint64_t> unsubscribe_pending_;     /// Track full name hash to withdraw due tick in ms
+
+        std::thread coalesce_thr_; /// Flushes coalesced peer stream data
+        std::mutex coalesce_mutex_;
+        std::condition_variable coalesce_cv_; /// Signals coalesce flush thread that earlier data is pending
+        std::vector<std::weak_ptr<PeerSession>> coalesce_sessions_; /// Peer sessions to flush coalesced data
+        uint64_t coalesce_wake_tick_us_{ 0 }; /// Tick in us the flush thread wakes at, guarded by coalesce_mutex_
+
+        /**
+         * @brief Info received from a peer node, used to resume sync after reconnect
+         */
+        struct PeerSyncCache
+        {
+            SyncState state; ///< Last completed sync, epoch is zero if none
+            std::map<NodeIdValueType, NodeInfo> nodes;
+            std::map<std::pair<quicr::TrackFullNameHash, NodeIdValueType>, AnnounceInfo> announces;
+            std::map<std::pair<quicr::TrackFullNameHash, NodeIdValueType>, SubscribeInfo> subscribes;
+        };
+
+        std::mutex sync_cache_mutex_;
+        std::map<NodeIdValueType, PeerSyncCache> peer_sync_cache_; /// Sync cache indexed by remote node id
+
         /// Subscribe track handler for received data
         std::map<quicr::messages::TrackAlias, std::shared_ptr<SubscribeTrackHandler>> subscribe_handlers_;
     };
@@ -8,6 +8,7 @@
 #include "peering/messages/node_info.h"
 #include "peering/messages/subscribe_info.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 
@@ -54,6 +55,12 @@ namespace laps::peering {
     {
         status_ = StatusValue::kConnecting;
         remote_node_info_ = {};
+        peer_version_ = kProtocolVersionMin;
+
+        {
+            std::lock_guard _(rx_sns_track_mutex_);
+            rx_sns_track_.clear();
+        }
 
         if (is_inbound_) {
             status_ = StatusValue::kConnected;
@@ -65,6 +72,11 @@ namespace laps::peering {
 
         peer_sns_.clear();
 
+        {
+            std::lock_guard _(coalesce_mutex_);
+            coalesce_pending_.clear();
+        }
+
         transport_ =
           quicr::ITransport::MakeClientTransport(peer_config_, transport_config_, *this, config_.tick_service_, LOGGER);
         t_conn_id_ = transport_->Start();
@@ -79,7 +91,8 @@ namespace laps::peering {
     std::pair<SubscribeNodeSetId, bool> PeerSession::AddPeerSnsSourceNode(PeerSessionId in_peer_session_id,
                                                                           SubscribeNodeSetId in_sns_id,
                                                                           NodeIdValueType sub_node_id,
-                                                                          uint8_t priority)
+                                                                          uint8_t priority,
+                                                                          quicr::TrackFullNameHash full_name_hash)
     {
         auto [it, new_ingress] = peer_sns_.try_emplace({ in_peer_session_id, in_sns_id });
         auto& sns = it->second;
@@ -88,6 +101,7 @@ namespace laps::peering {
             // TODO(tievens): Add datagram support - update transport to allow changing reliable state
             // TODO(tievens): Update transport to have max data context ID and to wrap if reaching max
             it->second.id = transport_->CreateDataContext(t_conn_id_, true, priority, false);
+            it->second.track_fullname_hash = full_name_hash;
         }
 
         auto [__, is_new] = sns.nodes.emplace(sub_node_id);
@@ -109,6 +123,7 @@ namespace laps::peering {
         if (it->second.id == 0) { // If not set, create the data context
             // TODO(tievens): Update transport to have max data context ID and to wrap if reaching max
             it->second.id = transport_->CreateDataContext(t_conn_id_, true, priority, false);
+            it->second.track_fullname_hash = full_name_hash;
         }
 
         auto [__, is_new] = sns.nodes.emplace(sub_node_id);
@@ -185,6 +200,18 @@ namespace laps::peering {
 
     void PeerSession::CloseStream(SubscribeNodeSetId sns_id, uint64_t stream_id, quicr::StreamClosedFlag flag)
     {
+        if (config_.peering.coalesce_window_us) {
+            std::lock_guard _(coalesce_mutex_);
+
+            // Pending data needs to be enqueued before the stream is closed
+            if (auto it = coalesce_pending_.find({ sns_id, stream_id }); it != coalesce_pending_.end()) {
+                auto& pending = it->second;
+                transport_->Enqueue(
+                  t_conn_id_, sns_id, stream_id, pending.data, pending.priority, pending.ttl, 0, pending.eflags);
+                coalesce_pending_.erase(it);
+            }
+        }
+
         transport_->CloseStream(t_conn_id_, sns_id, stream_id, flag == quicr::StreamClosedFlag::kReset);
     }
 
@@ -199,9 +226,162 @@ namespace laps::peering {
 
         if (status_ != StatusValue::kConnected)
             return;
+
+        if (config_.peering.coalesce_window_us && eflags.use_reliable &&
+            CoalesceData(priority, ttl, sns_id, stream_id, eflags, data)) {
+            return;
+        }
+
         transport_->Enqueue(t_conn_id_, sns_id, stream_id, data, priority, ttl, 0, eflags);
     }
 
+    std::shared_ptr<std::vector<uint8_t>> PeerSession::EncodeData(DataHeader data_header,
+                                                                  SubscribeNodeSetId out_sns_id,
+                                                                  bool track_known,
+                                                                  std::span<const uint8_t> payload) const
+    {
+        data_header.header_len = 0; // Header length is computed based on the encoding
+        data_header.sns_id = out_sns_id;
+        data_header.compact = peer_version_ >= kProtocolVersionCompactData;
+        data_header.implicit_track = data_header.compact && track_known;
+
+        auto data = std::make_shared<std::vector<uint8_t>>();
+        data->reserve(data_header.SizeBytes() + payload.size());
+
+        *data << data_header;
+        data->insert(data->end(), payload.begin(), payload.end());
+
+        return data;
+    }
+
+    void PeerSession::ResolveImplicitTrack(DataHeader& data_header) const
+    {
+        if (!data_header.implicit_track) {
+            return;
+        }
+
+        std::lock_guard _(rx_sns_track_mutex_);
+
+        if (auto it = rx_sns_track_.find(data_header.sns_id); it != rx_sns_track_.end()) {
+            data_header.track_full_name_hash = it->second;
+        } else {
+            SPDLOG_LOGGER_DEBUG(
+              LOGGER, "Received data with implicit track for unknown sns_id: {}", data_header.sns_id);
+        }
+    }
+
+    uint64_t PeerSession::CurrentTickUs() const
+    {
+        return static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(config_.tick_service_->get()).count());
+    }
+
+    bool PeerSession::CoalesceData(uint8_t priority,
+                                   uint32_t ttl,
+                                   SubscribeNodeSetId sns_id,
+                                   uint64_t stream_id,
+                                   const quicr::ITransport::EnqueueFlags& eflags,
+                                   const std::shared_ptr<const std::vector<uint8_t>>& data)
+    {
+        const auto max_bytes = config_.peering.coalesce_max_bytes;
+
+        // Highest priority data and stream control (new stream, reset, clear) are never delayed
+        const bool can_coalesce =
+          priority > 0 && !eflags.new_stream && !eflags.clear_tx_queue && !eflags.use_reset && data->size() < max_bytes;
+
+        uint64_t flush_tick_us{ 0 };
+
+        {
+            std::lock_guard _(coalesce_mutex_);
+
+            auto it = coalesce_pending_.find({ sns_id, stream_id });
+            if (it != coalesce_pending_.end()) {
+                auto& pending = it->second;
+
+                if (can_coalesce && pending.priority == priority && pending.ttl == ttl &&
+                    pending.data->size() + data->size() <= max_bytes) {
+                    pending.data->insert(pending.data->end(), data->begin(), data->end());
+
+                    // Full pending data is enqueued now instead of waiting for the window to expire
+                    if (pending.data->size() >= max_bytes) {
+                        transport_->Enqueue(t_conn_id_,
+                                            sns_id,
+                                            stream_id,
+                                            pending.data,
+                                            pending.priority,
+                                            pending.ttl,
+                                            0,
+                                            pending.eflags);
+                        coalesce_pending_.erase(it);
+                    }
+
+                    return true;
+                }
+
+                // Cannot merge, enqueue pending data first to keep the stream data in order
+                transport_->Enqueue(
+                  t_conn_id_, sns_id, stream_id, pending.data, pending.priority, pending.ttl, 0, pending.eflags);
+                coalesce_pending_.erase(it);
+            }
+
+            if (!can_coalesce) {
+                return false;
+            }
+
+            // Data is never held longer than 1/10th of the TTL
+            const uint64_t window_us =
+              std::min<uint64_t>(config_.peering.coalesce_window_us, static_cast<uint64_t>(ttl) * 100);
+
+            auto pending_data = std::make_shared<std::vector<uint8_t>>();
+            pending_data->reserve(max_bytes);
+            pending_data->assign(data->begin(), data->end());
+
+            flush_tick_us = CurrentTickUs() + window_us;
+
+            coalesce_pending_.try_emplace(
+              { sns_id, stream_id }, PendingData{ std::move(pending_data), priority, ttl, eflags, flush_tick_us });
+        }
+
+        // Not called with the lock held, the flush thread holds the manager lock while flushing sessions
+        manager_.CoalesceScheduled(flush_tick_us);
+
+        return true;
+    }
+
+    std::optional<uint64_t> PeerSession::FlushCoalescedData()
+    {
+        std::lock_guard _(coalesce_mutex_);
+
+        if (coalesce_pending_.empty()) {
+            return std::nullopt;
+        }
+
+        const auto current_tick_us = CurrentTickUs();
+        std::optional<uint64_t> next_flush_tick_us;
+
+        for (auto it = coalesce_pending_.begin(); it != coalesce_pending_.end();) {
+            auto& pending = it->second;
+
+            if (pending.flush_tick_us > current_tick_us) {
+                if (!next_flush_tick_us || pending.flush_tick_us < *next_flush_tick_us) {
+                    next_flush_tick_us = pending.flush_tick_us;
+                }
+                ++it;
+                continue;
+            }
+
+            if (status_ == StatusValue::kConnected) {
+                const auto& [sns_id, stream_id] = it->first;
+                transport_->Enqueue(
+                  t_conn_id_, sns_id, stream_id, pending.data, pending.priority, pending.ttl, 0, pending.eflags);
+            }
+
+            it = coalesce_pending_.erase(it);
+        }
+
+        return next_flush_tick_us;
+    }
+
     void PeerSession::SendSns(const SubscribeNodeSet& sns, bool withdraw)
     {
         if (status_ != StatusValue::kConnected)
@@ -243,7 +423,7 @@ namespace laps::peering {
                             subscribe_info.track_hash.track_fullname_hash,
                             NodeId().Value(subscribe_info.source_node_id),
                             withdraw,
-                            subscribe_info.subscribe_data.size());
+                            subscribe_info.SubscribeData().size());
 
         transport_->Enqueue(t_conn_id_,
                             control_data_ctx_id_,
@@ -254,15 +434,66 @@ namespace laps::peering {
                             1000);
     }
 
+    void PeerSession::SendBulkSync(const BulkSync& bulk_sync)
+    {
+        if (status_ != StatusValue::kConnected)
+            return;
+
+        SPDLOG_LOGGER_DEBUG(LOGGER,
+                            "Sending bulk sync entries: {} size: {}",
+                            bulk_sync.NumEntries(),
+                            bulk_sync.SizeBytes());
+
+        transport_->Enqueue(t_conn_id_,
+                            control_data_ctx_id_,
+                            control_stream_id_,
+                            std::make_shared<std::vector<uint8_t>>(bulk_sync.Serialize(true)),
+                            0,
+                            1000);
+    }
+
+    void PeerSession::SendSyncState(const SyncState& sync_state, bool request)
+    {
+        if (status_ != StatusValue::kConnected)
+            return;
+
+        SPDLOG_LOGGER_DEBUG(LOGGER,
+                            "Sending sync {} epoch: {} flags: {}",
+                            request ? "request" : "state",
+                            sync_state.epoch,
+                            sync_state.flags);
+
+        transport_->Enqueue(t_conn_id_,
+                            control_data_ctx_id_,
+                            control_stream_id_,
+                            std::make_shared<std::vector<uint8_t>>(sync_state.Serialize(true, request)),
+                            0,
+                            1000);
+    }
+
+    void PeerSession::StartInfoBaseSync()
+    {
+        if (peer_version_ >= kProtocolVersionSyncResume) {
+            // Peer syncs its information base to this session after receiving the versions to resume from
+            SendSyncState(manager_.GetSyncRequest(remote_node_info_.id), true);
+        } else {
+            manager_.InfoBaseSyncPeer(*this);
+        }
+    }
+
     void PeerSession::SendNodeInfo(const NodeInfo& node_info, bool withdraw)
     {
         if (status_ != StatusValue::kConnected)
             return;
         SPDLOG_LOGGER_DEBUG(LOGGER, "Sending node info id: {}", NodeId().Value(node_info.id));
+
+        auto peer_node_info = node_info;
+        peer_node_info.with_load = peer_version_ >= kProtocolVersionNodeLoad;
+
         transport_->Enqueue(t_conn_id_,
                             control_data_ctx_id_,
                             control_stream_id_,
-                            std::make_shared<std::vector<uint8_t>>(node_info.Serialize(true, withdraw)),
+                            std::make_shared<std::vector<uint8_t>>(peer_node_info.Serialize(true, withdraw)),
                             0,
                             1000);
     }
@@ -270,6 +501,7 @@ namespace laps::peering {
     void PeerSession::SendConnect()
     {
         peering::Connect connect;
+        connect.version = kProtocolVersion;
         connect.mode = PeerMode::kBoth;
         connect.node_info = node_info_;
 
@@ -287,6 +519,7 @@ namespace laps::peering {
     void PeerSession::SendConnectOk()
     {
         ConnectResponse connect_resp;
+        connect_resp.version = peer_version_;
         connect_resp.error = ProtocolError::kNoError;
         connect_resp.node_info = node_info_;
         SPDLOG_LOGGER_DEBUG(LOGGER, "Sending connect ok length: {}", connect_resp.Serialize().size());
@@ -351,131 +584,216 @@ namespace laps::peering {
         // Not used for outgoing connections. Incoming connections are handled by the server delegate
     }
 
-    void PeerSession::ProcessControlMessage()
-    try {
-        if (controL_msg_buffer_.size() >= kCommonHeadersSize) {
-            auto cursor_it = controL_msg_buffer_.begin();
-            auto bytes = std::span<uint8_t>{ cursor_it, cursor_it + kCommonHeadersSize };
-            cursor_it += kCommonHeadersSize;
+    template<typename Info>
+    void PeerSession::RecordSyncEntry(const Info& info, bool withdraw)
+    {
+        if (peer_version_ >= kProtocolVersionSyncResume) {
+            manager_.RecordSyncEntry(remote_node_info_.id, info, withdraw);
+        }
+    }
 
-            // TODO(tievens): Implement version checking and error handling
-            auto version = bytes.front();
-            auto type = ValueOf<uint16_t>({ bytes.begin() + 1, bytes.begin() + 3 });
-            auto data_len = ValueOf<uint32_t>({ bytes.begin() + 3, bytes.begin() + 7 });
+    void PeerSession::ProcessControlMessage(uint8_t version, MsgType type, std::span<uint8_t const> msg_bytes)
+    {
+        switch (type) {
+            case MsgType::kConnect: {
+                peering::Connect connect(msg_bytes);
 
-            if (controL_msg_buffer_.size() >= kCommonHeadersSize + data_len) {
-                auto msg_bytes = std::span{ cursor_it, cursor_it + data_len };
+                // Negotiated version is the lowest version supported by both sides
+                peer_version_ = std::min(version, kProtocolVersion);
 
-                // Control Message
-                switch (static_cast<MsgType>(type)) {
-                    case MsgType::kConnect: {
-                        peering::Connect connect(msg_bytes);
-                        SPDLOG_LOGGER_DEBUG(config_.logger_,
-                                            "Connect from id: {} contact: {} mode: {} version: {}",
-                                            NodeId().Value(connect.node_info.id),
-                                            connect.node_info.contact,
-                                            static_cast<int>(connect.mode),
-                                            static_cast<int>(version));
-                        remote_node_info_ = connect.node_info;
+                SPDLOG_LOGGER_DEBUG(config_.logger_,
+                                    "Connect from id: {} contact: {} mode: {} version: {}",
+                                    NodeId().Value(connect.node_info.id),
+                                    connect.node_info.contact,
+                                    static_cast<int>(connect.mode),
+                                    static_cast<int>(version));
+                remote_node_info_ = connect.node_info;
 
-                        status_ = StatusValue::kConnected;
+                status_ = StatusValue::kConnected;
 
-                        manager_.NodeReceived(GetSessionId(), connect.node_info, false);
-                        manager_.SessionChanged(GetSessionId(), status_, remote_node_info_);
+                manager_.NodeReceived(GetSessionId(), connect.node_info, false);
+                manager_.SessionChanged(GetSessionId(), status_, remote_node_info_);
 
-                        SendConnectOk();
+                SendConnectOk();
 
-                        manager_.InfoBaseSyncPeer(*this);
-                        break;
-                    }
+                StartInfoBaseSync();
+                break;
+            }
+
+            case MsgType::kConnectResponse: {
+                ConnectResponse connect_resp(msg_bytes);
+                peer_version_ = std::min(version, kProtocolVersion);
 
-                    case MsgType::kConnectResponse: {
-                        ConnectResponse connect_resp(msg_bytes);
+                if (connect_resp.error == ProtocolError::kNoError) {
+                    remote_node_info_ = *connect_resp.node_info;
+                    manager_.NodeReceived(GetSessionId(), *connect_resp.node_info, false);
 
-                        if (connect_resp.error == ProtocolError::kNoError) {
-                            remote_node_info_ = *connect_resp.node_info;
-                            manager_.NodeReceived(GetSessionId(), *connect_resp.node_info, false);
+                } else {
+                    SPDLOG_LOGGER_DEBUG(config_.logger_,
+                                        "Connect error response from error: {}",
+                                        static_cast<int>(connect_resp.error));
+                }
+                status_ = StatusValue::kConnected;
+                manager_.SessionChanged(GetSessionId(), status_, remote_node_info_);
 
-                            manager_.InfoBaseSyncPeer(*this);
+                StartInfoBaseSync();
+                break;
+            }
 
-                        } else {
-                            SPDLOG_LOGGER_DEBUG(config_.logger_,
-                                                "Connect error response from error: {}",
-                                                static_cast<int>(connect_resp.error));
-                        }
-                        status_ = StatusValue::kConnected;
-                        manager_.SessionChanged(GetSessionId(), status_, remote_node_info_);
+            case MsgType::kSubscribeNodeSetAdvertised: {
+                SubscribeNodeSet sns(msg_bytes, false);
 
-                        manager_.InfoBaseSyncPeer(*this);
-                        break;
+                if (config_.debug) {
+                    std::ostringstream sns_nodes;
+                    for (const auto& node : sns.nodes) {
+                        sns_nodes << NodeId().Value(node) << ", ";
                     }
 
-                    case MsgType::kSubscribeNodeSetAdvertised: {
-                        SubscribeNodeSet sns(msg_bytes, false);
+                    SPDLOG_LOGGER_DEBUG(LOGGER, "SNS received id: {} nodes: {}", sns.id, sns_nodes.str());
+                }
 
-                        if (config_.debug) {
-                            std::ostringstream sns_nodes;
-                            for (const auto& node : sns.nodes) {
-                                sns_nodes << NodeId().Value(node) << ", ";
-                            }
+                if (sns.track_fullname_hash) {
+                    std::lock_guard _(rx_sns_track_mutex_);
+                    rx_sns_track_[sns.id] = sns.track_fullname_hash;
+                }
 
-                            SPDLOG_LOGGER_DEBUG(LOGGER, "SNS received id: {} nodes: {}", sns.id, sns_nodes.str());
-                        }
+                manager_.SnsReceived(*this, sns, false);
+                break;
+            }
 
-                        manager_.SnsReceived(*this, sns, false);
-                        break;
-                    }
+            case MsgType::kSubscribeNodeSetWithdrawn: {
+                SubscribeNodeSet sns(msg_bytes, true);
+                SPDLOG_LOGGER_DEBUG(LOGGER, "SNS withdrawn received id: {}", sns.id);
 
-                    case MsgType::kSubscribeNodeSetWithdrawn: {
-                        SubscribeNodeSet sns(msg_bytes, true);
-                        SPDLOG_LOGGER_DEBUG(LOGGER, "SNS withdrawn received id: {}", sns.id);
-                        manager_.SnsReceived(*this, sns, true);
-                        break;
-                    }
+                {
+                    std::lock_guard _(rx_sns_track_mutex_);
+                    rx_sns_track_.erase(sns.id);
+                }
 
-                    case MsgType::kNodeInfoAdvertise: {
-                        NodeInfo node_info(msg_bytes);
-                        manager_.NodeReceived(GetSessionId(), node_info, false);
-                        break;
-                    }
+                manager_.SnsReceived(*this, sns, true);
+                break;
+            }
 
-                    case MsgType::kNodeInfoWithdrawn: {
-                        NodeInfo node_info(msg_bytes);
-                        manager_.NodeReceived(GetSessionId(), node_info, true);
-                        break;
-                    }
+            case MsgType::kNodeInfoAdvertise: {
+                NodeInfo node_info(msg_bytes, peer_version_ >= kProtocolVersionNodeLoad);
+                RecordSyncEntry(node_info, false);
+                manager_.NodeReceived(GetSessionId(), node_info, false);
+                break;
+            }
 
-                    case MsgType::kSubscribeInfoAdvertised: {
-                        SubscribeInfo subscribe_info(msg_bytes);
-                        manager_.SubscribeInfoReceived(GetSessionId(), subscribe_info, false);
-                        break;
-                    }
+            case MsgType::kNodeInfoWithdrawn: {
+                NodeInfo node_info(msg_bytes, peer_version_ >= kProtocolVersionNodeLoad);
+                RecordSyncEntry(node_info, true);
+                manager_.NodeReceived(GetSessionId(), node_info, true);
+                break;
+            }
 
-                    case MsgType::kSubscribeInfoWithdrawn: {
-                        SubscribeInfo subscribe_info(msg_bytes);
-                        manager_.SubscribeInfoReceived(GetSessionId(), subscribe_info, true);
-                        break;
-                    }
+            case MsgType::kSubscribeInfoAdvertised: {
+                SubscribeInfo subscribe_info(msg_bytes);
+                RecordSyncEntry(subscribe_info, false);
+                manager_.SubscribeInfoReceived(GetSessionId(), subscribe_info, false);
+                break;
+            }
 
-                    case MsgType::kAnnounceInfoAdvertised: {
-                        AnnounceInfo announce_info(msg_bytes);
-                        manager_.AnnounceInfoReceived(GetSessionId(), announce_info, false);
-                        break;
-                    }
+            case MsgType::kSubscribeInfoWithdrawn: {
+                SubscribeInfo subscribe_info(msg_bytes);
+                RecordSyncEntry(subscribe_info, true);
+                manager_.SubscribeInfoReceived(GetSessionId(), subscribe_info, true);
+                break;
+            }
 
-                    case MsgType::kAnnounceInfoWithdrawn: {
-                        AnnounceInfo announce_info(msg_bytes);
-                        manager_.AnnounceInfoReceived(GetSessionId(), announce_info, true);
-                        break;
-                    }
+            case MsgType::kAnnounceInfoAdvertised: {
+                AnnounceInfo announce_info(msg_bytes);
+                RecordSyncEntry(announce_info, false);
+                manager_.AnnounceInfoReceived(GetSessionId(), announce_info, false);
+                break;
+            }
+
+            case MsgType::kAnnounceInfoWithdrawn: {
+                AnnounceInfo announce_info(msg_bytes);
+                RecordSyncEntry(announce_info, true);
+                manager_.AnnounceInfoReceived(GetSessionId(), announce_info, true);
+                break;
+            }
+
+            case MsgType::kSyncRequest: {
+                SyncState request(msg_bytes);
+                SPDLOG_LOGGER_DEBUG(LOGGER,
+                                    "Sync request received epoch: {} nodes: {} announces: {} subscribes: {}",
+                                    request.epoch,
+                                    request.nodes_version,
+                                    request.announces_version,
+                                    request.subscribes_version);
+
+                manager_.InfoBaseSyncPeer(*this, request);
+                break;
+            }
+
+            case MsgType::kSyncState: {
+                SyncState sync_state(msg_bytes);
+                manager_.SyncStateReceived(*this, sync_state);
+                break;
+            }
 
-                    default: {
-                        SPDLOG_LOGGER_DEBUG(config_.logger_, "Invalid message type {}", static_cast<int>(type));
+            case MsgType::kBulkSync: {
+                BulkSync bulk_sync(msg_bytes);
+
+                SPDLOG_LOGGER_DEBUG(LOGGER, "Bulk sync received entries: {}", bulk_sync.entries.size());
+
+                for (const auto& entry : bulk_sync.entries) {
+                    switch (entry.type) {
+                        case MsgType::kNodeInfoAdvertise:
+                        case MsgType::kNodeInfoWithdrawn:
+                        case MsgType::kSubscribeInfoAdvertised:
+                        case MsgType::kSubscribeInfoWithdrawn:
+                        case MsgType::kAnnounceInfoAdvertised:
+                        case MsgType::kAnnounceInfoWithdrawn:
+                            ProcessControlMessage(version, entry.type, entry.data);
+                            break;
+
+                        default:
+                            SPDLOG_LOGGER_DEBUG(
+                              config_.logger_, "Invalid bulk sync entry type {}", static_cast<int>(entry.type));
+                            break;
                     }
                 }
+                break;
+            }
+
+            default: {
+                SPDLOG_LOGGER_DEBUG(config_.logger_, "Invalid message type {}", static_cast<int>(type));
+            }
+        }
+    }
+
+    void PeerSession::ProcessControlMessages()
+    try {
+        std::size_t offset{ 0 }; // Offset of the next message to parse in the working buffer
+
+        while (controL_msg_buffer_.size() - offset >= kCommonHeadersSize) {
+            auto cursor_it = controL_msg_buffer_.begin() + offset;
+            auto bytes = std::span<uint8_t>{ cursor_it, cursor_it + kCommonHeadersSize };
+            cursor_it += kCommonHeadersSize;
+
+            // TODO(tievens): Implement version checking and error handling
+            auto version = bytes.front();
+            auto type = ValueOf<uint16_t>({ bytes.begin() + 1, bytes.begin() + 3 });
+            auto data_len = ValueOf<uint32_t>({ bytes.begin() + 3, bytes.begin() + 7 });
 
-                controL_msg_buffer_.erase(controL_msg_buffer_.begin(), cursor_it + data_len);
+            if (controL_msg_buffer_.size() - offset < kCommonHeadersSize + data_len) {
+                break; // Wait for the rest of the message
             }
+
+            auto msg_bytes = std::span{ cursor_it, cursor_it + data_len };
+
+            ProcessControlMessage(version, static_cast<MsgType>(type), msg_bytes);
+
+            offset += kCommonHeadersSize + data_len;
+        }
+
+        // Remove all processed messages at once, leaving only the partial message (if any) at the front
+        if (offset > 0) {
+            controL_msg_buffer_.erase(controL_msg_buffer_.begin(), controL_msg_buffer_.begin() + offset);
         }
     } catch (const std::exception& e) {
         SPDLOG_LOGGER_ERROR(config_.logger_, "Unable to parse control message: {}", e.what());
@@ -486,14 +804,12 @@ namespace laps::peering {
                                           std::any& ctx,
                                           std::shared_ptr<const std::vector<uint8_t>> data)
     {
-        // TODO(tievens): Update to not buffer when node type is Via
-
         quicr::ITransport::EnqueueFlags eflags;
         eflags.use_reliable = stream_id.has_value(); // If stream isn't set, it's datagram
 
         // NEW STREAM - parse start of stream headers
         if (!ctx.has_value()) {
-            ctx.emplace<DataHeader>();
+            auto& stream_ctx = ctx.emplace<DataStreamContext>();
 
             auto cursor_it = data->begin();
             const auto hdr_len = *cursor_it;
@@ -508,22 +824,82 @@ namespace laps::peering {
                 return false; // Not enough bytes to parse the headers, wait till more arrives
             }
 
-            auto& data_header = std::any_cast<DataHeader&>(ctx);
-            data_header.Deserialize(*data);
+            if (!stream_ctx.data_header.Deserialize(*data)) {
+                SPDLOG_LOGGER_WARN(LOGGER,
+                                   "Received invalid data header on stream id: {}, dropping stream data",
+                                   stream_id.has_value() ? *stream_id : 0);
+
+                // Cut-through without egress drops all data of the stream
+                stream_ctx.cut_through = true;
+                return true;
+            }
+
+            ResolveImplicitTrack(stream_ctx.data_header);
+
+            // Via relays do not have clients, stream data is forwarded without parsing or buffering
+            if (config_.node_type == NodeType::kVia && eflags.use_reliable) {
+                stream_ctx.cut_through = manager_.ResolveStreamEgress(GetSessionId(), *stream_id, true, stream_ctx);
+            }
+
+            if (stream_ctx.cut_through) {
+                for (const auto& egress : stream_ctx.egress) {
+                    if (auto out_peer_sess = egress.peer_session.lock()) {
+                        // Start of stream header includes the SNS ID, which is different per egress peer
+                        auto data_out = out_peer_sess->EncodeData(stream_ctx.data_header,
+                                                                  egress.out_sns_id,
+                                                                  egress.track_known,
+                                                                  { data->begin() + hdr_len, data->end() });
+
+                        out_peer_sess->SendData(stream_ctx.data_header.priority,
+                                                stream_ctx.data_header.ttl,
+                                                egress.out_sns_id,
+                                                egress.out_stream_id,
+                                                eflags,
+                                                std::move(data_out));
+                    }
+                }
+
+                return true;
+            }
 
             // Pipeline forward to other peers.
-            manager_.ForwardPeerData(
-              GetSessionId(), true, stream_id.has_value() ? *stream_id : 0, data_header, data, hdr_len, eflags);
+            manager_.ForwardPeerData(GetSessionId(),
+                                     true,
+                                     stream_id.has_value() ? *stream_id : 0,
+                                     stream_ctx.data_header,
+                                     data,
+                                     hdr_len,
+                                     eflags);
 
             return true;
         }
 
         // Existing data
-        auto& data_header = std::any_cast<DataHeader&>(ctx);
+        auto& stream_ctx = *std::any_cast<DataStreamContext>(&ctx);
+
+        if (stream_ctx.cut_through && stream_ctx.EgressChanged()) {
+            stream_ctx.cut_through = manager_.ResolveStreamEgress(GetSessionId(), *stream_id, false, stream_ctx);
+        }
+
+        if (stream_ctx.cut_through) {
+            // Existing stream data has no header, same data is sent to all egress peers
+            for (const auto& egress : stream_ctx.egress) {
+                if (auto out_peer_sess = egress.peer_session.lock()) {
+                    out_peer_sess->SendData(stream_ctx.data_header.priority,
+                                            stream_ctx.data_header.ttl,
+                                            egress.out_sns_id,
+                                            egress.out_stream_id,
+                                            eflags,
+                                            data);
+                }
+            }
+
+            return true;
+        }
 
         // Pipeline forward to other peers. Not all data may have been popped, so only forward popped data
         manager_.ForwardPeerData(
-          GetSessionId(), false, stream_id.has_value() ? *stream_id : 0, data_header, data, 0, eflags);
+          GetSessionId(), false, stream_id.has_value() ? *stream_id : 0, stream_ctx.data_header, data, 0, eflags);
 
         return true;
     }
@@ -552,7 +928,7 @@ namespace laps::peering {
                 control_data_ctx_id_ = *data_ctx_id;
                 controL_msg_buffer_.insert(controL_msg_buffer_.end(), data->begin(), data->end());
 
-                ProcessControlMessage();
+                ProcessControlMessages();
 
             } else if (!ProcessReceivedData(stream_id, rx_ctx->caller_any, std::move(data))) {
                 i = 59;
@@ -573,7 +949,13 @@ namespace laps::peering {
                 return;
             }
 
-            DataHeader data_header(*data);
+            DataHeader data_header;
+            if (!data_header.Deserialize(*data)) {
+                SPDLOG_LOGGER_DEBUG(LOGGER, "Received datagram with invalid data header, dropping");
+                continue;
+            }
+
+            ResolveImplicitTrack(data_header);
 
             manager_.ForwardPeerData(GetSessionId(), false, 0, data_header, data, data_header.header_len, eflags);
 
@@ -590,6 +972,7 @@ namespace laps::peering {
                                                  const quicr::QuicConnectionMetrics& quic_connection_metrics)
     {
         metrics_.srtt_us = quic_connection_metrics.srtt_us.avg;
+        metrics_.tx_rate_bps = quic_connection_metrics.tx_rate_bps.avg;
     }
 
     void PeerSession::OnStreamClosed(const quicr::TransportConnId& connection_handle,
@@ -598,8 +981,11 @@ namespace laps::peering {
                                      [[maybe_unused]] std::optional<uint64_t> request_id,
                                      quicr::StreamClosedFlag flag)
     {
-        if (auto rx_ctx = transport_->GetStreamRxContext(connection_handle, stream_id)) {
-            auto& data_header = std::any_cast<DataHeader&>(rx_ctx->caller_any);
+        auto rx_ctx = transport_->GetStreamRxContext(connection_handle, stream_id);
+        const auto stream_ctx = rx_ctx ? std::any_cast<DataStreamContext>(&rx_ctx->caller_any) : nullptr;
+
+        if (stream_ctx) {
+            const auto& data_header = stream_ctx->data_header;
 
             SPDLOG_LOGGER_DEBUG(LOGGER,
                                 "Peer stream closed conn_id {} stream id: {} flag: {} track fullname hash: {}",
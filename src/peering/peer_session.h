@@ -3,19 +3,53 @@
 #pragma once
 
 #include <map>
+#include <mutex>
 #include <optional>
 #include <quicr/detail/quic_transport.h>
 #include <set>
 
 #include "config.h"
 #include "messages/announce_info.h"
+#include "messages/bulk_sync.h"
+#include "messages/data_header.h"
 #include "messages/node_info.h"
 #include "messages/subscribe_info.h"
 #include "messages/subscribe_node_set.h"
+#include "messages/sync_state.h"
 
 namespace laps::peering {
 
     class PeerManager;
+    class PeerSession;
+
+    /**
+     * @brief Receive context of a peer data stream
+     *
+     * @details Stored in the transport stream rx context on start of stream. Via relays resolve the
+     *   egress streams once on start of stream and forward subsequent stream data directly (cut-through)
+     *   using the egress list, without any forwarding table lookups per chunk of data.
+     */
+    struct DataStreamContext
+    {
+        struct Egress
+        {
+            std::weak_ptr<PeerSession> peer_session;
+            SubscribeNodeSetId out_sns_id{ 0 }; ///< Egress SNS ID
+            uint64_t out_stream_id{ 0 };        ///< Egress stream ID
+            bool track_known{ false };          ///< Egress SNS advertised the track full name hash
+        };
+
+        DataHeader data_header;
+        bool cut_through{ false };          ///< True when stream data is forwarded using the egress list
+        PeerFibVersion fib_version;         ///< Version of the ingress SNS peer FIB entry
+        uint64_t resolved_fib_version{ 0 }; ///< Value of fib_version that the egress list was resolved with
+        std::vector<Egress> egress;         ///< Resolved egress peer streams
+
+        /**
+         * @brief True if the ingress SNS peer FIB entry changed since the egress list was resolved
+         */
+        bool EgressChanged() const noexcept { return fib_version && *fib_version != resolved_fib_version; }
+    };
 
     /**
      * @brief Peering manager class. Manages relay to relay (peering) forwarding of
@@ -81,11 +115,51 @@ namespace laps::peering {
          */
         PeerSessionId GetSessionId() const { return t_conn_id_; }
 
+        /**
+         * @brief Get the negotiated protocol version of the peer session
+         */
+        uint8_t PeerVersion() const { return peer_version_; }
+
+        /**
+         * @brief Encode data header and payload to be sent via this peer session
+         *
+         * @details The data header is encoded using the negotiated protocol version. Compact (var-int)
+         *   data headers are used with peers that support it. The track full name hash is omitted when
+         *   the egress SNS advertisement included it.
+         *
+         * @param data_header       Data header to encode, SNS ID is replaced with the egress SNS ID
+         * @param out_sns_id        Egress SNS ID
+         * @param track_known       True if the egress SNS advertised the track full name hash
+         * @param payload           Payload bytes that follow the data header
+         *
+         * @returns Encoded data header and payload
+         */
+        std::shared_ptr<std::vector<uint8_t>> EncodeData(DataHeader data_header,
+                                                         SubscribeNodeSetId out_sns_id,
+                                                         bool track_known,
+                                                         std::span<const uint8_t> payload) const;
+
         uint64_t CreateStream(SubscribeNodeSetId sns_id, uint8_t priority) const;
         void CloseStream(SubscribeNodeSetId sns_id, uint64_t stream_id, quicr::StreamClosedFlag flag);
         void SendNodeInfo(const NodeInfo& node_info, bool withdraw = false);
         void SendSubscribeInfo(SubscribeInfo& subscribe_info, bool withdraw = false);
         void SendAnnounceInfo(const AnnounceInfo& announce_info, bool withdraw = false);
+
+        /**
+         * @brief Send bulk sync message with many information base entries
+         * @note Peer MUST have negotiated kProtocolVersionBulkSync or greater
+         */
+        void SendBulkSync(const BulkSync& bulk_sync);
+
+        /**
+         * @brief Send sync state or sync request
+         * @note Peer MUST have negotiated kProtocolVersionSyncResume or greater
+         *
+         * @param sync_state        Sync state to send
+         * @param request           True to send as sync request
+         */
+        void SendSyncState(const SyncState& sync_state, bool request = false);
+
         void SendSns(const SubscribeNodeSet& sns, bool withdraw = false);
         void SendData(uint8_t priority,
                       uint32_t ttl,
@@ -94,6 +168,14 @@ namespace laps::peering {
                       const quicr::ITransport::EnqueueFlags& eflags,
                       std::shared_ptr<const std::vector<uint8_t>> data);
 
+        /**
+         * @brief Flush coalesced stream data
+         * @details Enqueues coalesced stream data that has been pending for the coalesce window or longer.
+         *
+         * @returns Tick in microseconds when the next remaining pending data is due, nullopt if none is pending
+         */
+        std::optional<uint64_t> FlushCoalescedData();
+
         /**
          * @brief Add subscriber source node to the peer SNS state
          *
@@ -101,13 +183,15 @@ namespace laps::peering {
          * @param in_sns_id          Ingress peer session SNS ID
          * @param sub_node_id        Source NodeId of the node that has the subscriber
          * @param priority           Priority to use for the data context
+         * @param full_name_hash     Track full name hash of the ingress SNS, zero if not known
          *
          * @returns pair Subscribe Node Set Id and True if subscriber node is new or False if existing
          */
         std::pair<SubscribeNodeSetId, bool> AddPeerSnsSourceNode(PeerSessionId in_peer_session_id,
                                                                  SubscribeNodeSetId in_sns_id,
                                                                  NodeIdValueType sub_node_id,
-                                                                 uint8_t priority);
+                                                                 uint8_t priority,
+                                                                 quicr::TrackFullNameHash full_name_hash = 0);
 
         /**
          * @brief Add subscriber source node to subscriber id state
@@ -180,12 +264,64 @@ namespace laps::peering {
         void SendConnect();
         void SendConnectOk();
 
-        void ProcessControlMessage();
+        /**
+         * @brief Start information base sync after the peer session is connected
+         * @details Peers that support sync resume are sent a sync request. Legacy peers are sent
+         *   the information base in full.
+         */
+        void StartInfoBaseSync();
+
+        /**
+         * @brief Record info received from the peer to resume sync after reconnect
+         */
+        template<typename Info>
+        void RecordSyncEntry(const Info& info, bool withdraw);
+
+        /**
+         * @brief Process a single control message
+         *
+         * @param version       Protocol version from the common header
+         * @param type          Message type from the common header
+         * @param msg_bytes     Message data without common header
+         */
+        void ProcessControlMessage(uint8_t version, MsgType type, std::span<uint8_t const> msg_bytes);
+
+        /**
+         * @brief Process all complete control messages in the control message buffer
+         * @details Messages are parsed in place from the working buffer. Processed bytes are removed
+         *   once per call, which keeps processing linear when many messages are received back-to-back.
+         *   A trailing partial message is kept until the rest of it is received.
+         */
+        void ProcessControlMessages();
 
         bool ProcessReceivedData(std::optional<uint64_t> stream_id,
                                  std::any& ctx,
                                  std::shared_ptr<const std::vector<uint8_t>> data);
 
+        /**
+         * @brief Coalesce stream data with pending data for the same egress stream
+         *
+         * @details Small stream data is appended to the pending data of the egress stream. Pending
+         *   data is enqueued by the manager flush thread when the coalesce window expires, immediately when
+         *   max bytes is reached, or when data that cannot be merged (e.g., different priority or TTL) is sent
+         *   on the same stream.
+         *
+         * @returns True if data was coalesced, False if data should be enqueued by the caller
+         */
+        bool CoalesceData(uint8_t priority,
+                          uint32_t ttl,
+                          SubscribeNodeSetId sns_id,
+                          uint64_t stream_id,
+                          const quicr::ITransport::EnqueueFlags& eflags,
+                          const std::shared_ptr<const std::vector<uint8_t>>& data);
+
+        uint64_t CurrentTickUs() const;
+
+        /**
+         * @brief Set the track full name hash of a received data header that has an implicit track
+         */
+        void ResolveImplicitTrack(DataHeader& data_header) const;
+
       public:
         quicr::TransportRemote peer_config_;
         const Config& config_;
@@ -195,6 +331,7 @@ namespace laps::peering {
         struct Metrics
         {
             uint64_t srtt_us; /// smooth round trip time sampled from the transport, using average value
+            uint64_t tx_rate_bps{ 0 }; /// transmit rate sampled from the transport, using average value
         } metrics_;
 
       private:
@@ -203,6 +340,8 @@ namespace laps::peering {
 
         bool is_inbound_{ false }; /// Indicates if the peer is server accepted (inbound) or client (outbound)
 
+        uint8_t peer_version_{ kProtocolVersionMin }; /// Negotiated protocol version with the peer
+
         quicr::TransportConfig transport_config_{
             .tls_cert_filename = config_.tls_cert_filename_,
             .tls_key_filename = config_.tls_key_filename_,
@@ -218,11 +357,28 @@ namespace laps::peering {
         /// Key is the ingress peer session ID and SNS ID, value is the SNS egress via this peer
         std::map<std::pair<PeerSessionId, SubscribeNodeSetId>, SubscribeNodeSet> peer_sns_;
 
+        /// Track full name hash of SNS received from the peer, indexed by SNS ID. Used for implicit track data
+        std::unordered_map<SubscribeNodeSetId, quicr::TrackFullNameHash> rx_sns_track_;
+        mutable std::mutex rx_sns_track_mutex_; /// Guards rx_sns_track_, written by control and read by data path
+
         quicr::TransportConnId t_conn_id_;         /// Transport connection context ID (aka peer session id)
         quicr::DataContextId control_data_ctx_id_; /// Control data context ID
         uint64_t control_stream_id_{ 0 };          /// control bidir stream
         std::vector<uint8_t> controL_msg_buffer_;  /// Working buffer of control message being processed
 
+        struct PendingData
+        {
+            std::shared_ptr<std::vector<uint8_t>> data;
+            uint8_t priority{ 0 };
+            uint32_t ttl{ 0 };
+            quicr::ITransport::EnqueueFlags eflags;
+            uint64_t flush_tick_us{ 0 }; ///< Tick in microseconds when the pending data is to be enqueued
+        };
+
+        std::mutex coalesce_mutex_;
+        /// Coalesced stream data pending to be enqueued, indexed by egress SNS ID and stream ID
+        std::map<std::pair<SubscribeNodeSetId, uint64_t>, PendingData> coalesce_pending_;
+
         std::shared_ptr<quicr::ITransport> transport_; /// Transport used for the peering connection
     };
 
@@ -26,10 +26,13 @@ namespace laps {
 
         void SetBaseTrackAlias(uint64_t track_alias) { track_alias_ = track_alias; }
 
+        /**
+         * @brief End all subgroups of this publish track, e.g., when it is demoted from a top-n
+         * @details Only the streams to the subscriber of this publish track are ended. Peer streams of the
+         *      track are ended by the subscribe track handler of the publisher.
+         */
         void AbruptCloseAllSubgroups();
 
-        void EndSubgroup(uint64_t group_id, uint64_t subgroup_id, bool completed) override;
-
         static std::shared_ptr<PublishTrackHandler> Create(const quicr::FullTrackName& full_track_name,
                                                            quicr::TrackMode track_mode,
                                                            uint8_t default_priority,
@@ -4,6 +4,7 @@
 #include "publish_namespace_handler.h"
 
 #include "publish_handler.h"
+#include <algorithm>
 #include <unordered_set>
 
 namespace laps {
@@ -17,6 +18,14 @@ namespace laps {
 
 void
 laps::PublishNamespaceHandler::PublishTrack(std::shared_ptr<quicr::PublishTrackHandler> handler)
+{
+    std::lock_guard _(mutex_);
+
+    AddPublishTrack(std::move(handler));
+}
+
+void
+laps::PublishNamespaceHandler::AddPublishTrack(std::shared_ptr<quicr::PublishTrackHandler> handler)
 {
     quicr::PublishNamespaceHandler::PublishTrack(handler);
 
@@ -25,6 +34,7 @@ laps::PublishNamespaceHandler::PublishTrack(std::shared_ptr<quicr::PublishTrackH
         cur_ticks = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(tick_svc->get()).count());
     }
     published_tracks_.emplace(handler->GetTrackAlias().value(), ActiveTrack{ cur_ticks, handler });
+    new_published_tracks_.emplace(handler->GetTrackAlias().value());
 }
 
 quicr::PublishTrackHandler::PublishObjectStatus
@@ -36,6 +46,8 @@ laps::PublishNamespaceHandler::PublishObject(quicr::TrackFullNameHash track_full
     // TODO: Implement subscribe namespace level per track filters
     //      Process incoming watched extensions to form Top-N
 
+    std::lock_guard _(mutex_);
+
     if (const auto pub_it = handlers_.find(track_full_name_hash); pub_it != handlers_.end()) {
 
         auto handler = dynamic_pointer_cast<PublishTrackHandler>(pub_it->second);
@@ -66,6 +78,8 @@ laps::PublishNamespaceHandler::ForwardPublishedData(quicr::TrackFullNameHash tra
     // TODO: Implement subscribe namespace level per track filters
     //      Process incoming watched extensions to form Top-N
 
+    std::lock_guard _(mutex_);
+
     if (const auto pub_it = handlers_.find(track_full_name_hash); pub_it != handlers_.end()) {
 
         // Use pipeline forwarding now that first object has been sent
@@ -83,115 +97,293 @@ laps::PublishNamespaceHandler::ForwardPublishedData(quicr::TrackFullNameHash tra
 }
 
 void
-laps::PublishNamespaceHandler::UpdateTrackRanking(
-  std::span<const std::tuple<quicr::messages::TrackAlias, uint64_t, uint64_t, uint64_t>> ordered_tracks)
+laps::PublishNamespaceHandler::UpdateTrackRanking(const TrackRankingDelta& delta)
 {
-    if (!property_type_.has_value()) {
+    if (!property_type_.has_value() || *property_type_ != delta.property_type) {
         return;
     }
 
-    // Update latest tick for each publish track
-    for (auto& [ta, insert_seq_num, latest_tick, conn_id] : ordered_tracks) {
-        SPDLOG_DEBUG("DEBUG: conn_id: {} ta: {} insert_seq_num: {} latest_tick: {}",
-                     GetConnectionId(),
-                     ta,
-                     insert_seq_num,
-                     latest_tick);
+    std::lock_guard _(mutex_);
 
-        auto pub_it = published_tracks_.find(ta);
-        if (pub_it != published_tracks_.end()) {
-            pub_it->second.last_updated_tick = latest_tick;
-        }
+    timeq::tick_service::tick_type cur_tick{ 0 };
+    if (auto tick_svc = tick_service_.lock()) {
+        cur_tick = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(tick_svc->get()).count());
     }
 
-    std::unordered_map<uint64_t, uint64_t> active_tracks;
-    for (const auto& [ta, insert_seq_num, latest_tick, publisher_conn_id] : ordered_tracks) {
-        if (active_tracks.size() >= max_tracks_selected_) {
-            break;
-        }
+    if (delta.Empty() && new_published_tracks_.empty() && !dwell_blocked_) {
+        // Selected candidates did not change, top-n of this handler is unchanged
+        UnpublishDemoted(cur_tick);
+        return;
+    }
 
+    // Candidates in rank order that this handler can select
+    std::vector<Candidate> candidates;
+    for (const auto& [ta, insert_seq_num, latest_tick, publisher_conn_id, value] : delta.selected) {
         // Filter out self-tracks
         if (publisher_conn_id == GetConnectionId()) {
             SPDLOG_DEBUG("Skipping self-track {} (connection_id: {})", ta, publisher_conn_id);
             continue;
         }
 
-        SPDLOG_DEBUG("Update track tracking: Top track {} track alias: {} from conn {}",
-                     active_tracks.size(),
-                     ta,
-                     publisher_conn_id);
-
         auto pub_track_it = published_tracks_.find(ta);
-        if (pub_track_it == published_tracks_.end()) {
+        if (pub_track_it != published_tracks_.end()) {
+            pub_track_it->second.last_updated_tick = latest_tick;
+
+        } else if (!unpublished_tracks_.contains(ta) && !publish_track_factory_) {
             // Publish tracks should/must exists before this is call. They are managed by PublishTrack()
             SPDLOG_WARN("Track {} missing from publish_tracks; track alias: {} from conn {}",
-                        active_tracks.size(),
+                        candidates.size(),
                         ta,
                         publisher_conn_id);
             continue;
         }
 
-        if (auto h = pub_track_it->second.handler.lock(); h->GetStatus() == PublishTrackHandler::Status::kPaused) {
+        candidates.push_back({ ta, publisher_conn_id, value });
+    }
+
+    auto active_tracks = SelectTracks(candidates, cur_tick);
+
+    // Promote tracks that entered the top-n
+    std::vector<quicr::messages::TrackAlias> not_restored;
+    for (const auto& [ta, selected_tick] : active_tracks) {
+        if (active_tracks_.contains(ta)) {
+            continue;
+        }
+
+        demoted_tracks_.erase(ta);
+
+        std::shared_ptr<quicr::PublishTrackHandler> h;
+        if (const auto pub_track_it = published_tracks_.find(ta); pub_track_it != published_tracks_.end()) {
+            h = pub_track_it->second.handler.lock();
+
+        } else {
+            const auto cand_it = std::ranges::find(candidates, ta, &Candidate::track_alias);
+            h = RestorePublishTrack(ta, cand_it->connection_id, cur_tick);
+            if (h == nullptr) {
+                not_restored.push_back(ta);
+            }
+        }
+
+        if (h == nullptr) {
+            continue;
+        }
+
+        SPDLOG_DEBUG("Update track tracking: Top track alias: {} conn_id: {}", ta, GetConnectionId());
+
+        if (h->GetStatus() == PublishTrackHandler::Status::kPaused) {
             h->SetStatus(PublishTrackHandler::Status::kOk);
 
-            auto track_it = handlers_.find(ta);
-            if (track_it == handlers_.end()) {
-                SPDLOG_DEBUG("Track {} is newly selected and will undergo PUBLISH flow track alias: {} conn_id: {}",
-                             active_tracks.size(),
+            if (!handlers_.contains(ta)) {
+                SPDLOG_DEBUG("Track is newly selected and will undergo PUBLISH flow track alias: {} conn_id: {}",
                              ta,
-                             publisher_conn_id);
-                PublishTrack(h);
-            } else {
-                pub_track_it->second.last_updated_tick = latest_tick;
+                             GetConnectionId());
+                AddPublishTrack(h);
             }
         }
+    }
 
-        active_tracks.emplace(ta, latest_tick);
+    // Tracks no longer published to the relay are selected again when a candidate changes
+    for (const auto ta : not_restored) {
+        active_tracks.erase(ta);
     }
 
+    // Demote tracks that left the top-n, including tracks published since the last selection
+    for (const auto& [ta, selected_tick] : active_tracks_) {
+        if (!active_tracks.contains(ta)) {
+            switch_metrics_.switches++;
+        }
+        new_published_tracks_.insert(ta);
+    }
     if (published_tracks_.size() > max_tracks_selected_) {
-        // Unpublish tracks that are too old
-        for (auto& [ta, track] : published_tracks_) {
+        for (const auto ta : new_published_tracks_) {
             if (active_tracks.contains(ta)) {
-                // Skip, track is active
                 continue;
             }
 
-            timeq::tick_service::tick_type cur_tick{ 0 };
-            if (auto tick_svc = tick_service_.lock()) {
-                cur_tick = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(tick_svc->get()).count());
+            auto pub_it = published_tracks_.find(ta);
+            if (pub_it == published_tracks_.end()) {
+                continue;
             }
 
-            if (auto h = track.handler.lock()) {
-                if (h->GetStatus() == PublishTrackHandler::Status::kOk) {
-                    SPDLOG_INFO("Setting track to Paused, no longer in top-n alias: {} conn_id: {} ticks: {} < {}",
-                                ta,
-                                GetConnectionId(),
-                                track.last_updated_tick,
-                                cur_tick);
-
-                    if (auto hh = std::dynamic_pointer_cast<PublishTrackHandler>(h)) {
-                        hh->AbruptCloseAllSubgroups();
-                    }
-                    h->SetStatus(PublishTrackHandler::Status::kPaused);
+            if (auto h = pub_it->second.handler.lock(); h && h->GetStatus() == PublishTrackHandler::Status::kOk) {
+                SPDLOG_INFO("Setting track to Paused, no longer in top-n alias: {} conn_id: {} ticks: {} < {}"
+                            " switches: {} avoided hysteresis: {} avoided dwell: {}",
+                            ta,
+                            GetConnectionId(),
+                            pub_it->second.last_updated_tick,
+                            cur_tick,
+                            switch_metrics_.switches,
+                            switch_metrics_.avoided_hysteresis,
+                            switch_metrics_.avoided_dwell);
+
+                if (auto hh = std::dynamic_pointer_cast<PublishTrackHandler>(h)) {
+                    hh->AbruptCloseAllSubgroups();
                 }
+                h->SetStatus(PublishTrackHandler::Status::kPaused);
+                demoted_tracks_.try_emplace(ta, cur_tick);
+            }
+        }
+    }
 
-                if (cur_tick - track.last_updated_tick > delay_publish_done_ms_) {
-                    SPDLOG_INFO("Unpublish track, not in top-n track alias: {} conn_id: {} ticks: {} < {}",
-                                ta,
-                                GetConnectionId(),
-                                track.last_updated_tick,
-                                cur_tick);
-                    // UnPublishTrack(h);
-                }
+    new_published_tracks_.clear();
+    active_tracks_ = std::move(active_tracks);
+
+    UnpublishDemoted(cur_tick);
+}
+
+std::shared_ptr<quicr::PublishTrackHandler>
+laps::PublishNamespaceHandler::RestorePublishTrack(quicr::messages::TrackAlias track_alias,
+                                                   uint64_t connection_id,
+                                                   uint64_t cur_tick)
+{
+    std::shared_ptr<quicr::PublishTrackHandler> handler;
+
+    if (auto it = unpublished_tracks_.find(track_alias); it != unpublished_tracks_.end()) {
+        SPDLOG_DEBUG("Reusing unpublished track alias: {} conn_id: {}", track_alias, GetConnectionId());
+        handler = std::move(it->second.handler);
+        unpublished_tracks_.erase(it);
+
+    } else if (publish_track_factory_) {
+        SPDLOG_DEBUG("Creating publish track for unpublished track alias: {} conn_id: {}",
+                     track_alias,
+                     GetConnectionId());
+        handler = publish_track_factory_(track_alias, connection_id);
+    }
+
+    if (handler == nullptr) {
+        SPDLOG_WARN("Unable to restore unpublished track alias: {} from conn {}", track_alias, connection_id);
+        return nullptr;
+    }
+
+    // Promote flow publishes paused tracks that are not published
+    handler->SetStatus(quicr::PublishTrackHandler::Status::kPaused);
+    published_tracks_.insert_or_assign(track_alias, ActiveTrack{ cur_tick, handler });
+
+    return handler;
+}
+
+void
+laps::PublishNamespaceHandler::UnpublishDemoted(uint64_t cur_tick)
+{
+    for (auto it = demoted_tracks_.begin(); it != demoted_tracks_.end();) {
+        if (cur_tick - it->second <= delay_publish_done_ms_) {
+            ++it;
+            continue;
+        }
+
+        SPDLOG_INFO("Unpublish track, not in top-n track alias: {} conn_id: {} ticks: {} < {}",
+                    it->first,
+                    GetConnectionId(),
+                    it->second,
+                    cur_tick);
+
+        if (auto pub_it = published_tracks_.find(it->first); pub_it != published_tracks_.end()) {
+            if (auto h = pub_it->second.handler.lock()) {
+                UnPublishTrack(h);
+                unpublished_tracks_.insert_or_assign(it->first, UnpublishedTrack{ std::move(h), cur_tick });
+            }
+
+            published_tracks_.erase(pub_it);
+        }
+
+        it = demoted_tracks_.erase(it);
+    }
+
+    std::erase_if(unpublished_tracks_, [&](const auto& entry) {
+        return cur_tick - entry.second.unpublished_tick > unpublished_reuse_ms_;
+    });
+}
+
+std::map<quicr::messages::TrackAlias, uint64_t>
+laps::PublishNamespaceHandler::SelectTracks(const std::vector<Candidate>& candidates, uint64_t cur_tick)
+{
+    const auto num_selected = std::min<std::size_t>(candidates.size(), max_tracks_selected_);
+
+    dwell_blocked_ = false;
+
+    if (hysteresis_ == 0 && min_dwell_ms_ == 0) {
+        std::map<quicr::messages::TrackAlias, uint64_t> selected;
+        for (std::size_t i = 0; i < num_selected; ++i) {
+            const auto ta = candidates[i].track_alias;
+            auto it = active_tracks_.find(ta);
+            selected.emplace(ta, it != active_tracks_.end() ? it->second : cur_tick);
+        }
+
+        return selected;
+    }
+
+    // Keep selected tracks that are still candidates, by rank
+    std::vector<std::size_t> selected_ranks;
+    for (std::size_t rank = 0; rank < candidates.size(); ++rank) {
+        if (selected_ranks.size() < max_tracks_selected_ && active_tracks_.contains(candidates[rank].track_alias)) {
+            selected_ranks.push_back(rank);
+        }
+    }
+
+    // Tracks in the top-n by rank that are not selected challenge the lowest ranked selected track
+    for (std::size_t rank = 0; rank < num_selected; ++rank) {
+        if (std::ranges::find(selected_ranks, rank) != selected_ranks.end()) {
+            continue;
+        }
+
+        if (selected_ranks.size() < max_tracks_selected_) {
+            selected_ranks.push_back(rank);
+            continue;
+        }
+
+        // Lowest ranked selected track that has been selected for the minimum dwell time
+        auto replace_it = selected_ranks.end();
+        for (auto it = selected_ranks.begin(); it != selected_ranks.end(); ++it) {
+            const auto active_it = active_tracks_.find(candidates[*it].track_alias);
+            const auto selected_tick = active_it != active_tracks_.end() ? active_it->second : cur_tick;
+            if (cur_tick - selected_tick < min_dwell_ms_) {
+                continue;
+            }
+
+            if (replace_it == selected_ranks.end() || *it > *replace_it) {
+                replace_it = it;
             }
         }
+
+        if (replace_it == selected_ranks.end() || *replace_it < rank) {
+            SPDLOG_DEBUG("Switch avoided by min dwell, track alias: {} conn_id: {}",
+                         candidates[rank].track_alias,
+                         GetConnectionId());
+            switch_metrics_.avoided_dwell++;
+            dwell_blocked_ = true;
+            continue;
+        }
+
+        const auto& challenger = candidates[rank];
+        const auto& incumbent = candidates[*replace_it];
+        if (hysteresis_ > 0 && challenger.value <= incumbent.value + hysteresis_) {
+            SPDLOG_DEBUG("Switch avoided by hysteresis, track alias: {} value: {} selected alias: {} value: {}",
+                         challenger.track_alias,
+                         challenger.value,
+                         incumbent.track_alias,
+                         incumbent.value);
+            switch_metrics_.avoided_hysteresis++;
+            continue;
+        }
+
+        *replace_it = rank;
+    }
+
+    std::map<quicr::messages::TrackAlias, uint64_t> selected;
+    for (const auto rank : selected_ranks) {
+        const auto ta = candidates[rank].track_alias;
+        auto it = active_tracks_.find(ta);
+        selected.emplace(ta, it != active_tracks_.end() ? it->second : cur_tick);
     }
+
+    return selected;
 }
 
 void
 laps::PublishNamespaceHandler::EndSubgroup(uint64_t group_id, uint64_t subgroup_id, bool completed)
 {
+    std::lock_guard _(mutex_);
+
     for (auto& [ta, track] : published_tracks_) {
         if (auto handler = track.handler.lock()) {
             handler->EndSubgroup(group_id, subgroup_id, completed);
@@ -3,13 +3,39 @@
 #include "quicr/publish_namespace_handler.h"
 #include "quicr/track_name.h"
 
+#include <functional>
+#include <mutex>
+#include <set>
+#include <span>
 #include <unordered_map>
+#include <vector>
 
 namespace laps {
     class PublishTrackHandler;
 
+    /**
+     * @brief Change of the selected (top-n) candidate tracks of a track ranking property
+     */
+    struct TrackRankingDelta
+    {
+        /// Selected track <track alias, insert sequence number, latest tick, connection id, value>
+        using SelectedTrack = std::tuple<quicr::messages::TrackAlias, uint64_t, uint64_t, uint64_t, uint64_t>;
+
+        uint64_t property_type{ 0 };
+        std::span<const SelectedTrack> selected;                   // Selected tracks in rank order after the change
+        std::vector<quicr::messages::TrackAlias> entered;          // Tracks that are newly selected
+        std::vector<quicr::messages::TrackAlias> left;             // Tracks that are no longer selected
+        std::vector<quicr::messages::TrackAlias> rank_changed;     // Tracks still selected with a different rank
+
+        bool Empty() const noexcept { return entered.empty() && left.empty() && rank_changed.empty(); }
+    };
+
     /**
      * @brief  Publish namespace handler
+     * @details The handler is used by the transport thread to publish tracks and forward published data,
+     *      and by the track ranking to update the top-n. Both paths take the handler mutex. Lock order is
+     *      TrackRanking mutex, handler mutex, then State mutex that the publish track factory takes. The
+     *      handler MUST NOT be called with the State mutex held.
      */
     class PublishNamespaceHandler : public quicr::PublishNamespaceHandler
     {
@@ -50,31 +76,177 @@ namespace laps {
 
         /**
          * @brief Updates the track ranking
-         * @details TrackRanking instance calls this method for each namespace to update the top-n/ranked tracks
+         * @details TrackRanking instance calls this method for each namespace on every ranking update. The
+         *      top-n of the handler is only reselected when the selected candidate tracks changed or tracks
+         *      were published since the last selection. Only tracks that enter or leave the top-n of the
+         *      handler are published or paused. Paused tracks are unpublished after the publish done delay
+         *      and kept for reuse in case they are selected again.
          *
-         * @param ordered_tracks            Span of track property values with sequence number, latest tick, and
-         * connection IDs
+         * @param delta                 Change of the selected candidate tracks
          */
-        virtual void UpdateTrackRanking(
-          std::span<const std::tuple<quicr::messages::TrackAlias, uint64_t, uint64_t, uint64_t>> ordered_tracks);
+        virtual void UpdateTrackRanking(const TrackRankingDelta& delta);
 
         /*
          * Getter/Setters
          */
-        constexpr void SetMaxSelected(const uint64_t max) { max_tracks_selected_ = max; }
-        constexpr uint64_t GetMaxSelected() { return max_tracks_selected_; }
+        void SetMaxSelected(const uint64_t max)
+        {
+            std::lock_guard _(mutex_);
+            max_tracks_selected_ = max;
+        }
+        uint64_t GetMaxSelected()
+        {
+            std::lock_guard _(mutex_);
+            return max_tracks_selected_;
+        }
 
-        constexpr void SetInactiveAge(const uint64_t age_ms) { inactive_age_ms_ = age_ms; }
-        constexpr uint64_t GetInactiveAge() { return inactive_age_ms_; }
+        void SetInactiveAge(const uint64_t age_ms)
+        {
+            std::lock_guard _(mutex_);
+            inactive_age_ms_ = age_ms;
+        }
+        uint64_t GetInactiveAge()
+        {
+            std::lock_guard _(mutex_);
+            return inactive_age_ms_;
+        }
 
+        /// Property type to rank by. MUST be set before the handler is added to the track ranking
         constexpr void SetPropertyType(const uint64_t prop) { property_type_ = prop; }
         constexpr uint64_t GetPropertyType() { return property_type_.value_or(0); }
+        constexpr bool HasPropertyType() const noexcept { return property_type_.has_value(); }
+
+        /// Value margin a track must exceed the lowest ranked selected track by to replace it, zero disables
+        void SetHysteresis(const uint64_t margin)
+        {
+            std::lock_guard _(mutex_);
+            hysteresis_ = margin;
+        }
+        uint64_t GetHysteresis()
+        {
+            std::lock_guard _(mutex_);
+            return hysteresis_;
+        }
+
+        /// Minimum time in ms a track stays selected before it can be replaced, zero disables
+        void SetMinDwell(const uint64_t dwell_ms)
+        {
+            std::lock_guard _(mutex_);
+            min_dwell_ms_ = dwell_ms;
+        }
+        uint64_t GetMinDwell()
+        {
+            std::lock_guard _(mutex_);
+            return min_dwell_ms_;
+        }
+
+        /**
+         * @brief Top-n switch counters
+         */
+        struct SwitchMetrics
+        {
+            uint64_t switches{ 0 };           ///< Selected tracks replaced by another track
+            uint64_t avoided_hysteresis{ 0 }; ///< Switches avoided by the hysteresis value margin
+            uint64_t avoided_dwell{ 0 };      ///< Switches avoided by the minimum dwell time
+        };
+
+        SwitchMetrics GetSwitchMetrics() const
+        {
+            std::lock_guard _(mutex_);
+            return switch_metrics_;
+        }
+
+        /**
+         * @brief Creates the publish track of a ranked track that is no longer published by this handler
+         *
+         * @param track_alias           Track alias of the ranked track
+         * @param connection_id         Connection id of the publisher of the track
+         *
+         * @returns Publish track handler or nullptr if the track is no longer published to the relay
+         */
+        using PublishTrackFactory = std::function<std::shared_ptr<quicr::PublishTrackHandler>(
+          quicr::messages::TrackAlias track_alias,
+          uint64_t connection_id)>;
+
+        void SetPublishTrackFactory(PublishTrackFactory factory)
+        {
+            std::lock_guard _(mutex_);
+            publish_track_factory_ = std::move(factory);
+        }
+
+        /// Time in ms an unpublished track is kept for reuse if it's selected again
+        void SetUnpublishedReuse(const uint64_t reuse_ms)
+        {
+            std::lock_guard _(mutex_);
+            unpublished_reuse_ms_ = reuse_ms;
+        }
+        uint64_t GetUnpublishedReuse()
+        {
+            std::lock_guard _(mutex_);
+            return unpublished_reuse_ms_;
+        }
+
+        /// Number of tracks published by this handler, including paused tracks
+        std::size_t GetPublishedCount() const
+        {
+            std::lock_guard _(mutex_);
+            return published_tracks_.size();
+        }
+
+        /// Number of unpublished tracks kept for reuse
+        std::size_t GetUnpublishedCount() const
+        {
+            std::lock_guard _(mutex_);
+            return unpublished_tracks_.size();
+        }
 
       private:
+        struct Candidate
+        {
+            quicr::messages::TrackAlias track_alias;
+            uint64_t connection_id;
+            uint64_t value;
+        };
+
+        /**
+         * @brief Publish the track and add it to the published tracks. MUST be called with mutex_ held
+         */
+        void AddPublishTrack(std::shared_ptr<quicr::PublishTrackHandler> handler);
+
+        /**
+         * @brief Publish a selected track that was unpublished
+         * @details The unpublished handler is reused if it is still cached, otherwise a new handler is
+         *      created using the publish track factory. The track is added paused so that the promote
+         *      flow publishes it.
+         *
+         * @returns Publish track handler or nullptr if the track could not be restored
+         */
+        std::shared_ptr<quicr::PublishTrackHandler> RestorePublishTrack(quicr::messages::TrackAlias track_alias,
+                                                                        uint64_t connection_id,
+                                                                        uint64_t cur_tick);
+
+        /**
+         * @brief Unpublish demoted tracks that have been paused longer than the publish done delay
+         */
+        void UnpublishDemoted(uint64_t cur_tick);
+
+        /**
+         * @brief Select the top-n of this handler from the candidates in rank order
+         * @details Selected tracks are only replaced when the replacing track value exceeds the selected
+         *      track value by the hysteresis margin and the selected track was selected for the minimum dwell.
+         *
+         * @returns Selected tracks and the tick each was selected
+         */
+        std::map<quicr::messages::TrackAlias, uint64_t> SelectTracks(const std::vector<Candidate>& candidates,
+                                                                     uint64_t cur_tick);
+
+        mutable std::mutex mutex_; // Taken by the transport thread and the track ranking, see lock order above
+
         uint64_t max_tracks_selected_{ 1 };       // Max tracks to select as candidate top-n
         uint64_t inactive_age_ms_{ 10000 };       // Age in ms of a track that is considered stale/inactive
         std::optional<uint64_t> property_type_;   // Property type to rank by
         uint64_t delay_publish_done_ms_{ 20000 }; // Delay sending publish done to allow publish to come back
+        uint64_t unpublished_reuse_ms_{ 30000 };  // Time to keep unpublished tracks for reuse
 
         std::weak_ptr<timeq::tick_service> tick_service_;
 
@@ -85,5 +257,25 @@ namespace laps {
         };
 
         std::map<quicr::messages::TrackAlias, ActiveTrack> published_tracks_;
+
+        std::map<quicr::messages::TrackAlias, uint64_t> active_tracks_; // Top-n of this handler and tick selected
+        std::set<quicr::messages::TrackAlias> new_published_tracks_; // Tracks published since the last selection
+        std::map<quicr::messages::TrackAlias, uint64_t> demoted_tracks_; // Paused tracks and the tick paused
+
+        struct UnpublishedTrack
+        {
+            std::shared_ptr<quicr::PublishTrackHandler> handler;
+            uint64_t unpublished_tick;
+        };
+
+        /// Unpublished tracks kept for reuse until the reuse time expires
+        std::map<quicr::messages::TrackAlias, UnpublishedTrack> unpublished_tracks_;
+
+        PublishTrackFactory publish_track_factory_;
+
+        uint64_t hysteresis_{ 0 };    // Value margin to replace a selected track
+        uint64_t min_dwell_ms_{ 0 };  // Minimum time a track stays selected
+        bool dwell_blocked_{ false }; // A switch is pending on the minimum dwell time
+        SwitchMetrics switch_metrics_;
     };
 } // namespace laps
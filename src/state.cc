@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "state.h"
+
+#include "subscribe_handler.h"
+
+namespace laps {
+    void State::SetPubSubscribe(quicr::messages::TrackAlias track_alias,
+                                quicr::ConnectionHandle connection_handle,
+                                std::shared_ptr<SubscribeTrackHandler> handler)
+    {
+        ErasePubSubscribe(track_alias, connection_handle);
+
+        if (handler) {
+            const auto& name_space = handler->GetFullTrackName().name_space;
+
+            auto [ns_it, is_new] = pub_subscribes_by_namespace.try_emplace(name_space);
+            if (is_new) {
+                pub_subscribes_index.Add(name_space);
+            }
+
+            ns_it->second.emplace(track_alias, connection_handle);
+        }
+
+        pub_subscribes[{ track_alias, connection_handle }] = std::move(handler);
+    }
+
+    void State::ErasePubSubscribe(quicr::messages::TrackAlias track_alias, quicr::ConnectionHandle connection_handle)
+    {
+        auto it = pub_subscribes.find({ track_alias, connection_handle });
+        if (it == pub_subscribes.end()) {
+            return;
+        }
+
+        if (it->second) {
+            const auto& name_space = it->second->GetFullTrackName().name_space;
+
+            if (auto ns_it = pub_subscribes_by_namespace.find(name_space); ns_it != pub_subscribes_by_namespace.end()) {
+                ns_it->second.erase({ track_alias, connection_handle });
+
+                if (ns_it->second.empty()) {
+                    pub_subscribes_by_namespace.erase(ns_it);
+                    pub_subscribes_index.Remove(name_space);
+                }
+            }
+        }
+
+        pub_subscribes.erase(it);
+    }
+
+    std::vector<std::pair<quicr::messages::TrackAlias, quicr::ConnectionHandle>> State::GetPubSubscribesWithPrefix(
+      const quicr::TrackNamespace& prefix) const
+    {
+        std::vector<std::pair<quicr::messages::TrackAlias, quicr::ConnectionHandle>> keys;
+
+        for (const auto& name_space : pub_subscribes_index.WithPrefix(prefix)) {
+            if (auto it = pub_subscribes_by_namespace.find(name_space); it != pub_subscribes_by_namespace.end()) {
+                keys.insert(keys.end(), it->second.begin(), it->second.end());
+            }
+        }
+
+        return keys;
+    }
+
+    std::vector<std::pair<quicr::messages::TrackAlias, quicr::ConnectionHandle>> State::GetPubSubscribesMatching(
+      const quicr::TrackNamespace& name_space) const
+    {
+        std::vector<std::pair<quicr::messages::TrackAlias, quicr::ConnectionHandle>> keys;
+
+        for (const auto& match_ns : pub_subscribes_index.Matching(name_space)) {
+            if (auto it = pub_subscribes_by_namespace.find(match_ns); it != pub_subscribes_by_namespace.end()) {
+                keys.insert(keys.end(), it->second.begin(), it->second.end());
+            }
+        }
+
+        return keys;
+    }
+
+    std::vector<quicr::TrackNamespace> State::GetConnectionSubscribesNamespaces(
+      quicr::ConnectionHandle connection_handle) const
+    {
+        const auto it = connection_namespaces.find(connection_handle);
+        if (it == connection_namespaces.end()) {
+            return {};
+        }
+
+        return { it->second.subscribes_namespaces.begin(), it->second.subscribes_namespaces.end() };
+    }
+
+    std::vector<quicr::TrackNamespace> State::GetConnectionPubNamespaces(
+      quicr::ConnectionHandle connection_handle) const
+    {
+        const auto it = connection_namespaces.find(connection_handle);
+        if (it == connection_namespaces.end()) {
+            return {};
+        }
+
+        return { it->second.pub_namespace_active.begin(), it->second.pub_namespace_active.end() };
+    }
+}
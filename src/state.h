@@ -4,6 +4,9 @@
 #include <quicr/server.h>
 #include <set>
 
+#include "namespace_index.h"
+#include "state_table.h"
+
 namespace laps {
     class SubscribeTrackHandler;
     class PublishTrackHandler;
@@ -31,15 +34,18 @@ namespace laps {
                 kError,
             };
 
-            Type type;             ///< Type of request
-            State state;           ///< State of the request
-            std::any related_data; ///< Related data based on the type
+            Type type;                             ///< Type of request
+            State state;                           ///< State of the request
+            quicr::TrackNamespace track_namespace; ///< Namespace of the namespace request
         };
 
         /**
-         * Active requests by connection handle and request ID
+         * Active requests by request ID and connection handle
+         *
+         * @example
+         *      request = requests[request_id, connection_handle]
          */
-        std::map<std::pair<quicr::ConnectionHandle, quicr::messages::RequestID>, RequestTransaction> requests;
+        ConnectionTable<quicr::messages::RequestID, RequestTransaction> requests;
 
         /**
          * Map of subscribes (e.g., track alias) matched to a publish namespace
@@ -50,21 +56,30 @@ namespace laps {
         std::map<std::pair<quicr::TrackNamespace, quicr::ConnectionHandle>, std::set<quicr::messages::TrackAlias>>
           pub_namespace_active;
 
+        /**
+         * Namespaces of a connection in the namespace keyed tables. Entries are added and removed by the
+         *      methods below so that the state of a connection is cleaned up without scanning the tables.
+         */
+        struct ConnectionNamespaces
+        {
+            std::set<quicr::TrackNamespace> subscribes_namespaces; ///< Namespaces in subscribes_namespaces
+            std::set<quicr::TrackNamespace> pub_namespace_active;  ///< Namespaces in pub_namespace_active
+        };
+
+        std::unordered_map<quicr::ConnectionHandle, ConnectionNamespaces> connection_namespaces;
+
         /**
          * Active publisher/announce subscribes that this relay has made to receive objects from publisher.
          *
          * @example
          *      track_delegate = pub_subscribes[track_alias, connection handle]
          */
-        std::map<std::pair<quicr::messages::TrackAlias, quicr::ConnectionHandle>,
-                 std::shared_ptr<SubscribeTrackHandler>>
-          pub_subscribes;
+        ConnectionTable<quicr::messages::TrackAlias, std::shared_ptr<SubscribeTrackHandler>> pub_subscribes;
 
         /**
          * Active publisher initiated subscribes by request Id
          */
-        std::map<std::pair<uint64_t, quicr::ConnectionHandle>, std::shared_ptr<SubscribeTrackHandler>>
-          pub_subscribes_by_req_id;
+        ConnectionTable<quicr::messages::RequestID, std::shared_ptr<SubscribeTrackHandler>> pub_subscribes_by_req_id;
 
         /**
          * @brief Subscribe Namespace by connection to publish namespace handlers
@@ -94,18 +109,16 @@ namespace laps {
          *
          * @example track_handler = subscribes[track_alias, connection_handle]
          */
-        std::map<std::pair<quicr::messages::TrackAlias, quicr::ConnectionHandle>, SubscribePublishHandlerInfo>
-          subscribes;
+        ConnectionTable<quicr::messages::TrackAlias, SubscribePublishHandlerInfo> subscribes;
 
         /**
          * Request ID to alias mapping
          *      Used to lookup the track alias for a given request ID
          *
          * @example
-         *      track_alias = subscribe_alias_req_id[connection handle, request_id]
+         *      track_alias = subscribe_alias_req_id[request_id, connection handle]
          */
-        std::map<std::pair<quicr::ConnectionHandle, quicr::messages::RequestID>, quicr::messages::TrackAlias>
-          subscribe_alias_req_id;
+        ConnectionTable<quicr::messages::RequestID, quicr::messages::TrackAlias> subscribe_alias_req_id;
 
         /**
          * Map of subscribes set by namespace and track name hash
@@ -139,5 +152,155 @@ namespace laps {
         };
 
         std::map<std::pair<quicr::TrackNamespace, quicr::TrackNameHash>, std::set<SubscribeInfo>> subscribe_active_;
+
+        /**
+         * Namespace prefix indexes of the namespace keyed tables. Entries in these tables MUST be added and
+         *      removed using the methods below to keep the indexes in sync.
+         */
+        NamespaceIndex subscribes_namespaces_index; ///< Index of subscribes_namespaces
+        NamespaceIndex pub_namespace_active_index;  ///< Index of pub_namespace_active
+        NamespaceIndex subscribe_active_index;      ///< Index of subscribe_active_
+        NamespaceIndex pub_subscribes_index;        ///< Index of pub_subscribes_by_namespace
+
+        /**
+         * Publisher subscribe keys by the track namespace of the subscribe track handler
+         *
+         * @example
+         *      set<track_alias, connection_handle> = pub_subscribes_by_namespace[track_namespace]
+         */
+        std::map<quicr::TrackNamespace, std::set<std::pair<quicr::messages::TrackAlias, quicr::ConnectionHandle>>>
+          pub_subscribes_by_namespace;
+
+        /**
+         * Add the publish namespace handler of a connection to the subscribe namespace, an existing handler
+         *      of the connection is kept
+         *
+         * @returns Iterator to the handler of the connection and true if the subscribe namespace is new
+         */
+        auto AddSubscribesNamespace(const quicr::TrackNamespace& name_space,
+                                    quicr::ConnectionHandle connection_handle,
+                                    std::shared_ptr<PublishNamespaceHandler> handler)
+        {
+            auto [it, is_new] = subscribes_namespaces.try_emplace(name_space);
+            if (is_new) {
+                subscribes_namespaces_index.Add(name_space);
+            }
+
+            connection_namespaces[connection_handle].subscribes_namespaces.insert(name_space);
+
+            return std::pair{ it->second.emplace(connection_handle, std::move(handler)).first, is_new };
+        }
+
+        /**
+         * Erase the publish namespace handler of a connection from the subscribe namespace
+         *
+         * @returns True if the subscribe namespace was erased because no connections are left
+         */
+        bool EraseSubscribesNamespace(const quicr::TrackNamespace& name_space,
+                                      quicr::ConnectionHandle connection_handle)
+        {
+            if (auto conn_it = connection_namespaces.find(connection_handle); conn_it != connection_namespaces.end()) {
+                conn_it->second.subscribes_namespaces.erase(name_space);
+                EraseConnectionNamespaces(conn_it);
+            }
+
+            auto it = subscribes_namespaces.find(name_space);
+            if (it == subscribes_namespaces.end()) {
+                return false;
+            }
+
+            it->second.erase(connection_handle);
+            if (!it->second.empty()) {
+                return false;
+            }
+
+            subscribes_namespaces.erase(it);
+            subscribes_namespaces_index.Remove(name_space);
+            return true;
+        }
+
+        std::set<quicr::messages::TrackAlias>& AddPubNamespaceActive(const quicr::TrackNamespace& name_space,
+                                                                     quicr::ConnectionHandle connection_handle)
+        {
+            auto [it, is_new] = pub_namespace_active.try_emplace({ name_space, connection_handle });
+            if (is_new) {
+                pub_namespace_active_index.Add(name_space);
+                connection_namespaces[connection_handle].pub_namespace_active.insert(name_space);
+            }
+            return it->second;
+        }
+
+        void ErasePubNamespaceActive(const quicr::TrackNamespace& name_space, quicr::ConnectionHandle connection_handle)
+        {
+            if (pub_namespace_active.erase({ name_space, connection_handle })) {
+                pub_namespace_active_index.Remove(name_space);
+
+                if (auto conn_it = connection_namespaces.find(connection_handle);
+                    conn_it != connection_namespaces.end()) {
+                    conn_it->second.pub_namespace_active.erase(name_space);
+                    EraseConnectionNamespaces(conn_it);
+                }
+            }
+        }
+
+        std::set<SubscribeInfo>& AddSubscribeActive(const quicr::TrackNamespace& name_space,
+                                                    quicr::TrackNameHash name_hash)
+        {
+            auto [it, is_new] = subscribe_active_.try_emplace({ name_space, name_hash });
+            if (is_new) {
+                subscribe_active_index.Add(name_space);
+            }
+            return it->second;
+        }
+
+        void EraseSubscribeActive(const quicr::TrackNamespace& name_space, quicr::TrackNameHash name_hash)
+        {
+            if (subscribe_active_.erase({ name_space, name_hash })) {
+                subscribe_active_index.Remove(name_space);
+            }
+        }
+
+        /**
+         * Set the publisher subscribe handler for track alias and connection handle, replacing any existing
+         */
+        void SetPubSubscribe(quicr::messages::TrackAlias track_alias,
+                             quicr::ConnectionHandle connection_handle,
+                             std::shared_ptr<SubscribeTrackHandler> handler);
+
+        /**
+         * Erase the publisher subscribe handler for track alias and connection handle
+         */
+        void ErasePubSubscribe(quicr::messages::TrackAlias track_alias, quicr::ConnectionHandle connection_handle);
+
+        /**
+         * Get the publisher subscribe keys that have a track namespace starting with the prefix namespace
+         */
+        std::vector<std::pair<quicr::messages::TrackAlias, quicr::ConnectionHandle>> GetPubSubscribesWithPrefix(
+          const quicr::TrackNamespace& prefix) const;
+
+        /**
+         * Get the publisher subscribe keys that have the same prefix as the namespace
+         */
+        std::vector<std::pair<quicr::messages::TrackAlias, quicr::ConnectionHandle>> GetPubSubscribesMatching(
+          const quicr::TrackNamespace& name_space) const;
+
+        /**
+         * Get the subscribe namespaces of a connection
+         */
+        std::vector<quicr::TrackNamespace> GetConnectionSubscribesNamespaces(
+          quicr::ConnectionHandle connection_handle) const;
+
+        /**
+         * Get the active publish namespaces of a connection
+         */
+        std::vector<quicr::TrackNamespace> GetConnectionPubNamespaces(quicr::ConnectionHandle connection_handle) const;
+
+      private:
+        void EraseConnectionNamespaces(std::unordered_map<quicr::ConnectionHandle, ConnectionNamespaces>::iterator it)
+        {
+            if (it->second.subscribes_namespaces.empty() && it->second.pub_namespace_active.empty()) {
+                connection_namespaces.erase(it);
+            }
+        }
     };
 }
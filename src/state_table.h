@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+#pragma once
+
+#include <quicr/hash.h>
+#include <quicr/server.h>
+
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace laps {
+    /**
+     * @brief State table keyed by an id (e.g., track alias or request id) and connection handle
+     *
+     * @details Entries are hash indexed by <id, connection handle>. Two secondary indexes replace the
+     *      range scans of a map ordered by the key pair:
+     *          - Connection handles by id, in connection handle order. Finds every connection that has an
+     *            entry for an id, such as all publishers of a track alias.
+     *          - Ids by connection handle. Finds every entry of a connection without scanning the table.
+     *
+     *      Entries MUST be added and removed using the methods of the table to keep the indexes in sync.
+     *      Values can be modified in place. The index sets returned are invalidated when an entry of the
+     *      same id or connection handle is added or removed, copy them before modifying the table.
+     */
+    template<typename Id, typename Value>
+    class ConnectionTable
+    {
+      public:
+        using Key = std::pair<Id, quicr::ConnectionHandle>;
+
+        struct KeyHash
+        {
+            std::size_t operator()(const Key& key) const noexcept
+            {
+                uint64_t hash = static_cast<uint64_t>(key.first);
+                quicr::hash_combine(hash, static_cast<uint64_t>(key.second));
+                return hash;
+            }
+        };
+
+        using Entries = std::unordered_map<Key, Value, KeyHash>;
+        using iterator = typename Entries::iterator;
+        using const_iterator = typename Entries::const_iterator;
+
+        iterator begin() noexcept { return entries_.begin(); }
+        iterator end() noexcept { return entries_.end(); }
+        const_iterator begin() const noexcept { return entries_.begin(); }
+        const_iterator end() const noexcept { return entries_.end(); }
+
+        std::size_t size() const noexcept { return entries_.size(); }
+        bool empty() const noexcept { return entries_.empty(); }
+
+        iterator find(const Key& key) { return entries_.find(key); }
+        const_iterator find(const Key& key) const { return entries_.find(key); }
+        bool contains(const Key& key) const { return entries_.contains(key); }
+
+        Value& at(const Key& key) { return entries_.at(key); }
+        const Value& at(const Key& key) const { return entries_.at(key); }
+
+        template<typename... Args>
+        std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+        {
+            auto result = entries_.try_emplace(key, std::forward<Args>(args)...);
+            if (result.second) {
+                connections_by_id_[key.first].insert(key.second);
+                ids_by_connection_[key.second].insert(key.first);
+            }
+            return result;
+        }
+
+        Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+        iterator erase(iterator it)
+        {
+            EraseIndexes(it->first);
+            return entries_.erase(it);
+        }
+
+        std::size_t erase(const Key& key)
+        {
+            auto it = entries_.find(key);
+            if (it == entries_.end()) {
+                return 0;
+            }
+
+            erase(it);
+            return 1;
+        }
+
+        /**
+         * @brief Connection handles that have an entry for the id, in connection handle order
+         */
+        const std::set<quicr::ConnectionHandle>& Connections(const Id& id) const
+        {
+            static const std::set<quicr::ConnectionHandle> kNone;
+
+            const auto it = connections_by_id_.find(id);
+            return it != connections_by_id_.end() ? it->second : kNone;
+        }
+
+        /**
+         * @brief Ids that have an entry for the connection handle
+         */
+        const std::unordered_set<Id>& Ids(quicr::ConnectionHandle connection_handle) const
+        {
+            static const std::unordered_set<Id> kNone;
+
+            const auto it = ids_by_connection_.find(connection_handle);
+            return it != ids_by_connection_.end() ? it->second : kNone;
+        }
+
+      private:
+        void EraseIndexes(const Key& key)
+        {
+            if (auto it = connections_by_id_.find(key.first); it != connections_by_id_.end()) {
+                it->second.erase(key.second);
+                if (it->second.empty()) {
+                    connections_by_id_.erase(it);
+                }
+            }
+
+            if (auto it = ids_by_connection_.find(key.second); it != ids_by_connection_.end()) {
+                it->second.erase(key.first);
+                if (it->second.empty()) {
+                    ids_by_connection_.erase(it);
+                }
+            }
+        }
+
+        Entries entries_;
+        std::unordered_map<Id, std::set<quicr::ConnectionHandle>> connections_by_id_;
+        std::unordered_map<quicr::ConnectionHandle, std::unordered_set<Id>> ids_by_connection_;
+    };
+}
@@ -124,7 +124,8 @@ namespace laps {
         auto update = [ta = GetTrackAlias().value(),
                        conn_id = GetConnectionId(),
                        ticks = tick_service_.lock(),
-                       ranking = track_ranking_.lock()](
+                       ranking = track_ranking_.lock(),
+                       queued = server_.config_.ranking_interval_ms > 0](
                         uint64_t prop, PublishNamespaceHandler::TrackPropertyValue& value, uint64_t recv_value) {
             timeq::tick_service::tick_type cur_tick{ 0 };
             if (ticks != nullptr) {
@@ -135,7 +136,9 @@ namespace laps {
                 value.latest_value = recv_value;
                 value.latest_tick_ms = cur_tick;
 
-                if (ranking) {
+                if (ranking && queued) {
+                    ranking->QueueValue(ta, prop, value.latest_value, value.latest_tick_ms, conn_id);
+                } else if (ranking) {
                     ranking->UpdateValue(ta, prop, value.latest_value, value.latest_tick_ms, conn_id);
                 }
             }
@@ -349,6 +352,7 @@ namespace laps {
             if (subscribers_.contains(0)) { // Is peering subscribed
                 server_.peer_manager_.ClientDataRecv(
                   msg.track_alias,
+                  GetConnectionId(),
                   GetPriority(),
                   GetDeliveryTimeout().value_or(std::chrono::milliseconds(kDefaultObjectTtl)).count(),
                   peering::DataType::kDatagram,
@@ -417,6 +421,7 @@ namespace laps {
             if (conn_handle == 0) { // from peer
                 server_.peer_manager_.ClientDataRecv(
                   *track_alias,
+                  self_connection_handle,
                   GetPriority(),
                   GetDeliveryTimeout().value_or(std::chrono::milliseconds(kDefaultObjectTtl)).count(),
                   d_type,
@@ -445,10 +450,12 @@ namespace laps {
                 case Status::kError:
                     reason = "subscribe error";
                     if (GetTrackAlias().has_value()) {
-                        auto& anno_tracks =
-                          server_.state_.pub_namespace_active[{ GetFullTrackName().name_space, GetConnectionId() }];
-                        anno_tracks.erase(GetTrackAlias().value());
-                        server_.state_.pub_subscribes.erase({ GetTrackAlias().value(), GetConnectionId() });
+                        auto& pub_namespace_active = server_.state_.pub_namespace_active;
+                        auto anno_it = pub_namespace_active.find({ GetFullTrackName().name_space, GetConnectionId() });
+                        if (anno_it != pub_namespace_active.end()) {
+                            anno_it->second.erase(GetTrackAlias().value());
+                        }
+                        server_.state_.ErasePubSubscribe(GetTrackAlias().value(), GetConnectionId());
                     }
                     break;
                 case Status::kNotAuthorized:
@@ -499,6 +506,7 @@ namespace laps {
                 // Notify peering manager
                 if (GetTrackAlias().has_value()) {
                     server_.peer_manager_.EndSubgroup(GetTrackAlias().value(),
+                                                      GetConnectionId(),
                                                       stream_it->second.current_group_id,
                                                       stream_it->second.current_subgroup_id,
                                                       use_reset);
@@ -2,14 +2,27 @@
 
 #include "publish_namespace_handler.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <span>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
 namespace laps {
     /**
      * @brief Track ranking by property type, track alias and value of track
+     *
+     * @details A ranked view of the tracks is maintained for each property type in the same ranking. Each
+     *      publish namespace handler is notified only of the view of the property it ranks by, so subscribers
+     *      of the same namespace with different track filter property types share one ranking.
      */
     class TrackRanking
     {
@@ -17,16 +30,18 @@ namespace laps {
         using PropertyType = uint64_t;
         using TrackAlias = uint64_t;
         using PropertyValue = uint64_t;
-        struct TrackTickInfo
-        {
-            uint64_t insert_seq_num; // Track ranking update value sequence number
-            uint64_t latest_tick;    // Most recent tick value for the track
-        };
-        using TrackEntry = std::unordered_map<TrackAlias, TrackTickInfo>; // Stores insert and latest ticks
+        using SelectedTrack = TrackRankingDelta::SelectedTrack;
+
+        static constexpr uint64_t kExpiryWheelSlotMs{ 100 };  ///< Inactive expiry timer wheel slot resolution
+        static constexpr std::size_t kExpiryWheelSlots{ 256 }; ///< Number of timer wheel slots, horizon of 25.6s
 
         /**
          * @brief Update track ranking value for property type and track alias
          *
+         * @details The track is repositioned in the ranked set of the property, which is O(log N), and
+         *      rescheduled in the inactive expiry timer wheel. Only the top max selected tracks are read
+         *      to notify the handlers of the change in selected tracks.
+         *
          * @param track_alias           Track alias to update
          * @param prop                  Property type value
          * @param value                 Value of the property
@@ -38,126 +53,160 @@ namespace laps {
                          const uint64_t tick,
                          const uint64_t connection_id)
         {
-            // Increment sequence number for this update
-            ++update_value_seq_num_;
+            std::lock_guard _(mutex_);
 
-            // Check if track exists in a different value bucket
-            bool needs_rebuild = false;
-            bool value_decreased = false;
-            for (auto it = ordered_tracks_.lower_bound({ prop, 0 });
-                 it != ordered_tracks_.end() && it->first.first == prop;) {
-                if (it->first.second != value && it->second.contains(track_alias)) {
-                    if (it->first.second > value) {
-                        value_decreased = true;
-                    }
+            ApplyValue(track_alias, prop, value, tick, connection_id);
 
-                    it->second.erase(track_alias); // Remove from old bucket
-                    if (it->second.empty()) {
-                        it = ordered_tracks_.erase(it); // erase returns next iterator
-                        continue;
-                    }
-                    needs_rebuild = true;
+            // Expired tracks of other properties are gone from the wheel, their handlers are notified now
+            auto props = ExpireInactive(tick).props;
+            props.insert(prop);
+
+            for (const auto p : props) {
+                UpdateSelected(p);
+            }
+        }
+
+        /**
+         * @brief Queue a track ranking value to be applied by the ranking worker
+         *
+         * @details Lock-free, the sample is pushed to a multiple producer single consumer queue so that
+         *      the object receive path does not wait on ranking updates or handler notifications. Samples
+         *      are applied by ProcessQueued(). Parameters are the same as UpdateValue().
+         */
+        void QueueValue(const TrackAlias track_alias,
+                        const uint64_t prop,
+                        const uint64_t value,
+                        const uint64_t tick,
+                        const uint64_t connection_id)
+        {
+            auto* sample = new QueuedSample{ track_alias, prop, value, tick, connection_id, nullptr };
+
+            sample->next = queued_head_.load(std::memory_order_relaxed);
+            while (!queued_head_.compare_exchange_weak(
+              sample->next, sample, std::memory_order_release, std::memory_order_relaxed)) {
+            }
+        }
+
+        /**
+         * @brief Apply queued values as a batch
+         *
+         * @details Takes all queued samples at once. Samples are coalesced so that only the latest sample
+         *      of each track and property is applied. The selection of each updated property is computed
+         *      and the handlers notified once for the batch.
+         *
+         * @returns Number of samples applied after coalescing
+         */
+        std::size_t ProcessQueued()
+        {
+            auto* sample = queued_head_.exchange(nullptr, std::memory_order_acquire);
+            if (sample == nullptr) {
+                return 0;
+            }
+
+            // Queue is newest first, the first sample of a track and property is the latest
+            std::vector<QueuedSample> batch;
+            std::set<std::pair<PropertyType, TrackAlias>> coalesced;
+            while (sample != nullptr) {
+                std::unique_ptr<QueuedSample> owned(sample);
+                sample = sample->next;
+
+                if (coalesced.emplace(owned->prop, owned->track_alias).second) {
+                    batch.push_back(*owned);
                 }
-                ++it;
             }
 
-            auto [prop_it, inserted] = ordered_tracks_.try_emplace({ prop, value });
+            std::lock_guard _(mutex_);
 
-            // Check if track is new to this bucket
-            bool track_is_new = !prop_it->second.contains(track_alias);
+            // Apply in the order received
+            uint64_t tick{ 0 };
+            std::set<PropertyType> props;
+            for (auto it = batch.rbegin(); it != batch.rend(); ++it) {
+                ApplyValue(it->track_alias, it->prop, it->value, it->tick, it->connection_id);
+                tick = std::max(tick, it->tick);
+                props.insert(it->prop);
+            }
 
-            if (track_is_new) {
-                auto seq_num = value_decreased ? (std::numeric_limits<uint64_t>::max() >> 1) - update_value_seq_num_
-                                               : 1ULL << 63 | update_value_seq_num_;
-                prop_it->second[track_alias] = {
-                    seq_num, tick
-                }; // insert_seq_num is current sequence, latest_tick set to current tick
-            } else {
-                prop_it->second[track_alias].latest_tick = tick; // Only update latest_tick for existing tracks
+            for (const auto prop : ExpireInactive(tick).props) {
+                props.insert(prop);
             }
 
-            // Store connection ID for this track
-            track_connections_[track_alias] = connection_id;
+            for (const auto prop : props) {
+                UpdateSelected(prop);
+            }
 
-            // Rebuild if track moved buckets or new bucket was created
-            needs_rebuild = needs_rebuild || inserted;
+            return batch.size();
+        }
 
-            SPDLOG_DEBUG("Update Value ta: {} prop: {} value: {} tick: {} conn_id: {}",
-                         track_alias,
-                         prop,
-                         value,
-                         tick,
-                         connection_id);
+        /**
+         * @brief Expire tracks that have not been updated within the inactive age
+         *
+         * @details Advances the expiry timer wheel to the tick. Only the slots passed since the last
+         *      advance are visited, so the cost is the number of expired tracks instead of the number of
+         *      tracks. The relay calls this periodically so that tracks expire without updates to the
+         *      ranking. Handlers are notified of the change in selection for each property that had a track expire.
+         *
+         * @param tick                  Current tick value
+         *
+         * @returns Number of tracks expired
+         */
+        std::size_t Expire(const uint64_t tick)
+        {
+            std::lock_guard _(mutex_);
 
-            // Remove inactive tracks from ordered_tracks_
-            for (auto it = ordered_tracks_.begin(); it != ordered_tracks_.end();) {
-                auto& entry = it->second;
-                for (auto track_it = entry.begin(); track_it != entry.end();) {
-                    const auto& tick_info = track_it->second;
-                    if (tick >= tick_info.latest_tick && tick - tick_info.latest_tick > inactive_age_ms_) {
-                        track_it = entry.erase(track_it);
-                        needs_rebuild = true;
-                    } else {
-                        ++track_it;
-                    }
-                }
-                if (entry.empty()) {
-                    it = ordered_tracks_.erase(it);
-                } else {
-                    ++it;
-                }
+            const auto expired = ExpireInactive(tick);
+
+            for (const auto prop : expired.props) {
+                UpdateSelected(prop);
             }
 
-            if (needs_rebuild) {
-                flat_track_list_.clear();
+            return expired.count;
+        }
+
+        /**
+         * @brief Get the selected (top-n) tracks of the property, in rank order
+         */
+        std::vector<SelectedTrack> GetSelectedTracks(const PropertyType prop)
+        {
+            std::lock_guard _(mutex_);
 
-                auto first = ordered_tracks_.lower_bound({ prop, 0 });
-                auto last = ordered_tracks_.upper_bound({ prop, std::numeric_limits<PropertyValue>::max() });
+            if (auto it = selected_.find(prop); it != selected_.end()) {
+                return it->second;
+            }
+            return {};
+        }
 
-                for (auto it = std::make_reverse_iterator(last); it != std::make_reverse_iterator(first); ++it) {
-                    auto& [key, entry] = *it;
+        /**
+         * @brief Compute the change from the previous selected tracks to the selected tracks
+         *
+         * @param previous              Previous selected tracks in rank order
+         * @param delta                 Delta with selected set to the new selected tracks in rank order,
+         *                              updated with the tracks that entered, left or changed rank
+         */
+        static void ComputeDelta(std::span<const SelectedTrack> previous, TrackRankingDelta& delta)
+        {
+            std::unordered_map<TrackAlias, std::size_t> previous_rank;
+            for (std::size_t rank = 0; rank < previous.size(); ++rank) {
+                previous_rank.emplace(std::get<0>(previous[rank]), rank);
+            }
 
-                    std::vector<std::tuple<TrackAlias, uint64_t, uint64_t, uint64_t>> sort_tracks;
-                    for (const auto& [ta, tick_info] : entry) {
-                        sort_tracks.emplace_back(
-                          ta, tick_info.insert_seq_num, tick_info.latest_tick, track_connections_[ta]);
-                    }
-                    std::ranges::sort(sort_tracks, [](const auto& a, const auto& b) {
-                        if (std::get<1>(a) != std::get<1>(b))
-                            return std::get<1>(a) < std::get<1>(b); // ascending insert_seq_num
-                        return std::get<0>(a) > std::get<0>(b);
-                    });
+            for (std::size_t rank = 0; rank < delta.selected.size(); ++rank) {
+                const auto track_alias = std::get<0>(delta.selected[rank]);
 
-                    flat_track_list_.insert(flat_track_list_.end(), sort_tracks.begin(), sort_tracks.end());
+                auto it = previous_rank.find(track_alias);
+                if (it == previous_rank.end()) {
+                    delta.entered.push_back(track_alias);
+                    continue;
                 }
 
-            } else {
-                // Update latest_tick in flat_track_list_ in-place
-                for (auto& [alias, insert_seq_num, latest_tick, conn_id] : flat_track_list_) {
-                    if (alias == track_alias) {
-                        latest_tick = tick;
-                        conn_id = connection_id;
-                        break;
-                    }
+                if (it->second != rank) {
+                    delta.rank_changed.push_back(track_alias);
                 }
+                previous_rank.erase(it);
             }
 
-            // notify each subscribe namespace (aka publish namespace handler)
-            for (auto ns_it = ns_handlers_.begin(); ns_it != ns_handlers_.end();) {
-                auto& [ns_hash, conn_handlers] = *ns_it;
-                for (auto conn_it = conn_handlers.begin(); conn_it != conn_handlers.end();) {
-                    if (auto h = conn_it->second.lock()) {
-                        h->UpdateTrackRanking(flat_track_list_);
-                        ++conn_it;
-                    } else {
-                        conn_it = conn_handlers.erase(conn_it); // returns next iterator
-                    }
-                }
-                // Remove namespace entry if no handlers left
-                if (conn_handlers.empty()) {
-                    ns_it = ns_handlers_.erase(ns_it);
-                } else {
-                    ++ns_it;
+            for (const auto& track : previous) {
+                if (previous_rank.contains(std::get<0>(track))) {
+                    delta.left.push_back(std::get<0>(track));
                 }
             }
         }
@@ -165,25 +214,71 @@ namespace laps {
         /*
          * Getter/Setters
          */
-        constexpr void SetMaxSelected(const uint64_t max) { max_tracks_selected_ = max; }
-        constexpr uint64_t GetMaxSelected() { return max_tracks_selected_; }
+        void SetMaxSelected(const uint64_t max)
+        {
+            std::lock_guard _(mutex_);
+            max_tracks_selected_ = max;
+        }
+        uint64_t GetMaxSelected()
+        {
+            std::lock_guard _(mutex_);
+            return max_tracks_selected_;
+        }
 
-        constexpr void SetInactiveAge(const uint64_t age_ms) { inactive_age_ms_ = age_ms; }
-        constexpr uint64_t GetInactiveAge() { return inactive_age_ms_; }
+        void SetInactiveAge(const uint64_t age_ms)
+        {
+            std::lock_guard _(mutex_);
+            inactive_age_ms_ = age_ms;
+        }
+        uint64_t GetInactiveAge()
+        {
+            std::lock_guard _(mutex_);
+            return inactive_age_ms_;
+        }
 
         void AddNamespaceHandler(std::weak_ptr<PublishNamespaceHandler> handler)
         {
-            if (auto h = handler.lock()) {
+            std::lock_guard _(mutex_);
+
+            // Handlers are notified only of the ranked view of the property they rank by
+            if (auto h = handler.lock(); h && h->HasPropertyType()) {
                 auto th = quicr::TrackHash({ .name_space = h->GetPrefix(), .name = {} });
-                ns_handlers_[th.track_namespace_hash].try_emplace(h->GetConnectionId(), handler);
+                prop_handlers_[h->GetPropertyType()][th.track_namespace_hash].try_emplace(h->GetConnectionId(),
+                                                                                           handler);
             }
         }
 
         void RemoveNamespaceHandler(std::weak_ptr<PublishNamespaceHandler> handler)
         {
+            std::lock_guard _(mutex_);
+
             if (auto h = handler.lock()) {
                 auto th = quicr::TrackHash({ .name_space = h->GetPrefix(), .name = {} });
-                ns_handlers_[th.track_namespace_hash].erase(h->GetConnectionId());
+
+                for (auto prop_it = prop_handlers_.begin(); prop_it != prop_handlers_.end();) {
+                    auto& ns_handlers = prop_it->second;
+                    if (auto ns_it = ns_handlers.find(th.track_namespace_hash); ns_it != ns_handlers.end()) {
+                        ns_it->second.erase(h->GetConnectionId());
+                        if (ns_it->second.empty()) {
+                            ns_handlers.erase(ns_it);
+                        }
+                    }
+
+                    if (ns_handlers.empty()) {
+                        prop_it = prop_handlers_.erase(prop_it);
+                    } else {
+                        ++prop_it;
+                    }
+                }
+            }
+        }
+
+        ~TrackRanking()
+        {
+            auto* sample = queued_head_.exchange(nullptr);
+            while (sample != nullptr) {
+                std::unique_ptr<QueuedSample> owned(sample);
+                sample = sample->next;
             }
         }
 
@@ -193,30 +288,311 @@ namespace laps {
         uint64_t inactive_age_ms_{ 10000 };  // Age in ms of a track that is considered stale/inactive
         uint64_t update_value_seq_num_{ 0 }; // Track ranking update value sequence number
 
-        struct TrackInfo
+        std::mutex mutex_; // Ranking is updated by subscribe handlers and expired by the relay
+
+        /**
+         * @brief Property sample queued to be applied by the ranking worker
+         */
+        struct QueuedSample
         {
-            uint64_t latest_value{ 0 };
-            uint64_t latest_tick_ms{ 0 };
+            TrackAlias track_alias;
+            PropertyType prop;
+            PropertyValue value;
+            uint64_t tick;
+            uint64_t connection_id;
+            QueuedSample* next; // Next older sample in the queue
         };
 
+        std::atomic<QueuedSample*> queued_head_{ nullptr }; // Lock-free queue of samples, newest first
+
         /**
-         * @brief Ordered list of tracks.
-         *
-         * @details Key is a pair of PropertyType and PropertyValue. The value is a set of pairs. Each value pair
-         *      conveys the latest tick value  and track alias.
-         *      Sorting is performed by sorting both the map and the set.  The sort order is by property type,
-         *      property value, and latest tick value.
+         * @brief Position of a track in the ranked set of a property
+         */
+        struct RankKey
+        {
+            PropertyValue value{ 0 };
+            uint64_t insert_seq_num{ 0 }; // Track ranking update value sequence number when value changed
+            TrackAlias track_alias{ 0 };
+        };
+
+        /**
+         * @brief Rank order is by descending value, ascending insert sequence number and descending track alias
+         */
+        struct RankOrder
+        {
+            bool operator()(const RankKey& a, const RankKey& b) const
+            {
+                if (a.value != b.value)
+                    return a.value > b.value;
+                if (a.insert_seq_num != b.insert_seq_num)
+                    return a.insert_seq_num < b.insert_seq_num;
+                return a.track_alias > b.track_alias;
+            }
+        };
+
+        using RankedSet = std::set<RankKey, RankOrder>;
+
+        struct ExpiryEntry
+        {
+            PropertyType prop{ 0 };
+            TrackAlias track_alias{ 0 };
+        };
+
+        using ExpirySlot = std::list<ExpiryEntry>;
+
+        struct RankedTrack
+        {
+            RankedSet::iterator rank_it;    // Handle to the track position in the ranked set
+            uint64_t latest_tick{ 0 };      // Most recent tick value for the track
+            std::size_t expiry_slot{ 0 };   // Expiry timer wheel slot of the track
+            ExpirySlot::iterator expiry_it; // Handle to the track entry in the expiry slot
+        };
+
+        /**
+         * @brief Ranking of tracks for a property type
+         * @details Tracks are indexed by track alias to their position in the ranked set, so that
+         *      an update does not need to search for the previous value of the track.
+         */
+        struct PropertyRanking
+        {
+            RankedSet ranked;
+            std::unordered_map<TrackAlias, RankedTrack> tracks;
+        };
+
+        /**
+         * @brief Update the track value in the ranked set and expiry wheel of the property
+         */
+        void ApplyValue(const TrackAlias track_alias,
+                        const PropertyType prop,
+                        const PropertyValue value,
+                        const uint64_t tick,
+                        const uint64_t connection_id)
+        {
+            // Increment sequence number for this update
+            ++update_value_seq_num_;
+
+            auto& ranking = rankings_[prop];
+
+            auto [track_it, insert] = ranking.tracks.try_emplace(track_alias);
+            auto& ranked_track = track_it->second;
+
+            bool value_decreased = false;
+            const bool is_new = insert;
+            if (!insert) {
+                // Track moves to a different value, remove from old position
+                if (ranked_track.rank_it->value != value) {
+                    value_decreased = ranked_track.rank_it->value > value;
+                    ranking.ranked.erase(ranked_track.rank_it);
+                    insert = true;
+                }
+            }
+
+            if (insert) {
+                auto seq_num = value_decreased ? (std::numeric_limits<uint64_t>::max() >> 1) - update_value_seq_num_
+                                               : 1ULL << 63 | update_value_seq_num_;
+                ranked_track.rank_it = ranking.ranked.insert({ value, seq_num, track_alias }).first;
+            }
+
+            ranked_track.latest_tick = tick;
+            ScheduleExpiry(prop, track_alias, ranked_track, is_new);
+
+            // Store connection ID for this track
+            track_connections_[track_alias] = connection_id;
+
+            SPDLOG_DEBUG("Update Value ta: {} prop: {} value: {} tick: {} conn_id: {}",
+                         track_alias,
+                         prop,
+                         value,
+                         tick,
+                         connection_id);
+        }
+
+        /**
+         * @brief Tick a track expires at, which is when it has not been updated for more than the inactive age
+         */
+        uint64_t ExpiryTick(const RankedTrack& ranked_track) const
+        {
+            return ranked_track.latest_tick + inactive_age_ms_ + 1;
+        }
+
+        static std::size_t ExpirySlotOf(const uint64_t tick) { return (tick / kExpiryWheelSlotMs) % kExpiryWheelSlots; }
+
+        /**
+         * @brief Schedule or reschedule the track in the expiry timer wheel based on its latest tick
+         */
+        void ScheduleExpiry(const PropertyType prop,
+                            const TrackAlias track_alias,
+                            RankedTrack& ranked_track,
+                            const bool is_new)
+        {
+            const auto slot = ExpirySlotOf(ExpiryTick(ranked_track));
+
+            if (is_new) {
+                ranked_track.expiry_it = expiry_wheel_[slot].insert(expiry_wheel_[slot].end(), { prop, track_alias });
+            } else if (slot != ranked_track.expiry_slot) {
+                expiry_wheel_[slot].splice(
+                  expiry_wheel_[slot].end(), expiry_wheel_[ranked_track.expiry_slot], ranked_track.expiry_it);
+            }
+
+            ranked_track.expiry_slot = slot;
+        }
+
+        struct ExpiredTracks
+        {
+            std::size_t count{ 0 };
+            std::set<PropertyType> props; // Properties that had tracks expire
+        };
+
+        /**
+         * @brief Advance the expiry timer wheel to the tick, removing tracks that are inactive
          *
+         * @details Entries in a passed slot that are not yet due, because of a later wheel round or an
+         *      increased inactive age, are moved to the slot of their expiry tick.
+         */
+        ExpiredTracks ExpireInactive(const uint64_t tick)
+        {
+            ExpiredTracks expired;
+
+            if (tick < expiry_tick_) {
+                return expired;
+            }
+
+            const auto first_slot = expiry_tick_ / kExpiryWheelSlotMs;
+            const auto num_slots = std::min<uint64_t>(tick / kExpiryWheelSlotMs - first_slot + 1, kExpiryWheelSlots);
+            expiry_tick_ = tick;
+
+            for (uint64_t i = 0; i < num_slots; ++i) {
+                const auto slot_index = static_cast<std::size_t>((first_slot + i) % kExpiryWheelSlots);
+                auto& slot = expiry_wheel_[slot_index];
+
+                for (auto it = slot.begin(); it != slot.end();) {
+                    const auto [prop, track_alias] = *it;
+                    auto& ranking = rankings_.at(prop);
+                    auto track_it = ranking.tracks.find(track_alias);
+                    auto& ranked_track = track_it->second;
+
+                    if (const auto expiry_tick = ExpiryTick(ranked_track); expiry_tick > tick) {
+                        const auto next_it = std::next(it);
+                        if (const auto due_slot = ExpirySlotOf(expiry_tick); due_slot != slot_index) {
+                            expiry_wheel_[due_slot].splice(expiry_wheel_[due_slot].end(), slot, it);
+                            ranked_track.expiry_slot = due_slot;
+                        }
+                        it = next_it;
+                        continue;
+                    }
+
+                    SPDLOG_DEBUG("Expire inactive ta: {} prop: {} latest_tick: {} tick: {}",
+                                 track_alias,
+                                 prop,
+                                 ranked_track.latest_tick,
+                                 tick);
+
+                    it = slot.erase(it);
+                    ranking.ranked.erase(ranked_track.rank_it);
+                    ranking.tracks.erase(track_it);
+
+                    if (ranking.tracks.empty()) {
+                        rankings_.erase(prop);
+                    }
+
+                    ++expired.count;
+                    expired.props.insert(prop);
+                }
+            }
+
+            return expired;
+        }
+
+        /**
+         * @brief Select the top max selected tracks of the property in rank order and notify the handlers
+         *      of the change
          */
-        std::map<std::pair<PropertyType, PropertyValue>, TrackEntry> ordered_tracks_;
-        std::vector<std::tuple<TrackAlias, uint64_t, uint64_t, uint64_t>>
-          flat_track_list_;                                          // <alias, insert_seq_num, latest_tick, conn_id>
+        void UpdateSelected(const PropertyType prop)
+        {
+            std::vector<SelectedTrack> selected;
+
+            if (auto rank_it = rankings_.find(prop); rank_it != rankings_.end()) {
+                const auto& ranking = rank_it->second;
+                for (const auto& key : ranking.ranked) {
+                    if (selected.size() >= max_tracks_selected_) {
+                        break;
+                    }
+
+                    const auto latest_tick = ranking.tracks.at(key.track_alias).latest_tick;
+                    selected.emplace_back(
+                      key.track_alias, key.insert_seq_num, latest_tick, track_connections_[key.track_alias], key.value);
+                }
+            }
+
+            auto& prev_selected = selected_[prop];
+
+            TrackRankingDelta delta;
+            delta.property_type = prop;
+            delta.selected = selected;
+            ComputeDelta(prev_selected, delta);
+
+            prev_selected = std::move(selected);
+            delta.selected = prev_selected;
+
+            NotifyHandlers(delta);
+
+            if (prev_selected.empty()) {
+                selected_.erase(prop);
+            }
+        }
+
+        std::unordered_map<PropertyType, PropertyRanking> rankings_; // Ranked tracks by property type
+
+        /// Inactive expiry timer wheel, each slot covers kExpiryWheelSlotMs of expiry ticks
+        std::array<ExpirySlot, kExpiryWheelSlots> expiry_wheel_;
+        uint64_t expiry_tick_{ 0 }; // Tick the expiry timer wheel was last advanced to
+
+        std::unordered_map<PropertyType, std::vector<SelectedTrack>> selected_; // Top-n tracks by property type
         std::unordered_map<TrackAlias, uint64_t> track_connections_; // Map track alias to connection ID
 
+        /**
+         * @brief Notify each subscribe namespace (aka publish namespace handler) that ranks by the property of
+         *      the change in selected tracks
+         */
+        void NotifyHandlers(const TrackRankingDelta& delta)
+        {
+            auto prop_it = prop_handlers_.find(delta.property_type);
+            if (prop_it == prop_handlers_.end()) {
+                return;
+            }
+
+            auto& ns_handlers = prop_it->second;
+            for (auto ns_it = ns_handlers.begin(); ns_it != ns_handlers.end();) {
+                auto& [ns_hash, conn_handlers] = *ns_it;
+                for (auto conn_it = conn_handlers.begin(); conn_it != conn_handlers.end();) {
+                    if (auto h = conn_it->second.lock()) {
+                        h->UpdateTrackRanking(delta);
+                        ++conn_it;
+                    } else {
+                        conn_it = conn_handlers.erase(conn_it); // returns next iterator
+                    }
+                }
+                // Remove namespace entry if no handlers left
+                if (conn_handlers.empty()) {
+                    ns_it = ns_handlers.erase(ns_it);
+                } else {
+                    ++ns_it;
+                }
+            }
+
+            if (ns_handlers.empty()) {
+                prop_handlers_.erase(prop_it);
+            }
+        }
+
         /**
          * @brief Publish namespace handlers that are related to this track ranking
          * @details Indexed by namespace hash, then by connection ID
          */
-        std::map<quicr::TrackNamespaceHash, std::map<uint64_t, std::weak_ptr<PublishNamespaceHandler>>> ns_handlers_;
+        using NamespaceHandlers =
+          std::map<quicr::TrackNamespaceHash, std::map<uint64_t, std::weak_ptr<PublishNamespaceHandler>>>;
+
+        /// Publish namespace handlers by the property type they rank by
+        std::unordered_map<PropertyType, NamespaceHandlers> prop_handlers_;
     };
 }
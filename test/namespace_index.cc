@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <doctest/doctest.h>
+
+#include "namespace_index.h"
+
+using namespace std::string_literals;
+
+namespace laps {
+
+    TEST_SUITE("NamespaceIndex")
+    {
+        const auto ns_a = quicr::TrackNamespace{ "a"s };
+        const auto ns_ab = quicr::TrackNamespace{ "a"s, "b"s };
+        const auto ns_abc = quicr::TrackNamespace{ "a"s, "b"s, "c"s };
+        const auto ns_abd = quicr::TrackNamespace{ "a"s, "b"s, "d"s };
+        const auto ns_x = quicr::TrackNamespace{ "x"s };
+
+        TEST_CASE("Prefix matching")
+        {
+            NamespaceIndex index;
+            index.Add(ns_ab);
+            index.Add(ns_abc);
+            index.Add(ns_abd);
+            index.Add(ns_x);
+
+            CHECK_EQ(index.Size(), 4);
+
+            CHECK_EQ(index.WithPrefix(ns_a).size(), 3);
+            CHECK_EQ(index.WithPrefix(ns_ab).size(), 3);
+            CHECK_EQ(index.WithPrefix(ns_abc), std::vector{ ns_abc });
+            CHECK(index.WithPrefix(quicr::TrackNamespace{ "b"s }).empty());
+
+            CHECK(index.PrefixesOf(ns_a).empty());
+            CHECK_EQ(index.PrefixesOf(ns_abc), std::vector{ ns_ab, ns_abc });
+
+            CHECK_EQ(index.Matching(ns_abc), std::vector{ ns_ab, ns_abc });
+            CHECK_EQ(index.Matching(ns_a).size(), 3);
+            CHECK_EQ(index.Matching(ns_x), std::vector{ ns_x });
+
+            // Results match a linear scan using HasSamePrefix
+            const std::vector all{ ns_ab, ns_abc, ns_abd, ns_x };
+            for (const auto& lookup : { ns_a, ns_ab, ns_abc, ns_abd, ns_x }) {
+                std::vector<quicr::TrackNamespace> expected;
+                for (const auto& ns : all) {
+                    if (ns.HasSamePrefix(lookup)) {
+                        expected.push_back(ns);
+                    }
+                }
+                std::sort(expected.begin(), expected.end());
+
+                CHECK_EQ(index.Matching(lookup), expected);
+            }
+        }
+
+        TEST_CASE("Reference counted remove")
+        {
+            NamespaceIndex index;
+            index.Add(ns_ab);
+            index.Add(ns_ab);
+            index.Add(ns_abc);
+
+            index.Remove(ns_ab);
+            CHECK_EQ(index.Matching(ns_ab).size(), 2);
+
+            index.Remove(ns_ab);
+            CHECK_EQ(index.Matching(ns_ab), std::vector{ ns_abc });
+
+            index.Remove(ns_abc);
+            CHECK_EQ(index.Size(), 0);
+            CHECK(index.WithPrefix(ns_a).empty());
+
+            // Removing a namespace that is not indexed is ignored
+            index.Remove(ns_x);
+            CHECK_EQ(index.Size(), 0);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#include <doctest/doctest.h>
+
+#include "peering/messages/announce_info.h"
+#include "peering/messages/bulk_sync.h"
+#include "peering/messages/node_info.h"
+
+using namespace std::string_literals;
+
+TEST_CASE("Serialize Bulk Sync")
+{
+    using namespace laps::peering;
+
+    NodeInfo node_info;
+    node_info.id = NodeId().Value("1:1");
+    node_info.contact = "relay-1.example.com";
+
+    AnnounceInfo announce_info;
+    announce_info.source_node_id = 0xff00aabbcc;
+    announce_info.name_space = quicr::messages::TrackNamespace{ "abc"s, "12345"s };
+    announce_info.fullname_hash = 0x9876543210;
+
+    BulkSync bulk_sync;
+    bulk_sync.Add(MsgType::kNodeInfoAdvertise, node_info);
+    bulk_sync.Add(MsgType::kAnnounceInfoAdvertised, announce_info);
+
+    CHECK_EQ(bulk_sync.NumEntries(), 2);
+    CHECK_EQ(bulk_sync.SizeBytes(),
+             1 + quicr::UintVar(node_info.SizeBytes()).Size() + node_info.SizeBytes() + 1 +
+               quicr::UintVar(announce_info.SizeBytes()).Size() + announce_info.SizeBytes());
+
+    auto net_data = bulk_sync.Serialize(true);
+    CHECK_EQ(net_data.size(), kCommonHeadersSize + bulk_sync.SizeBytes());
+    CHECK_EQ(ValueOf<uint16_t>({ net_data.begin() + 1, net_data.begin() + 3 }),
+             static_cast<uint16_t>(MsgType::kBulkSync));
+
+    BulkSync decoded({ net_data.begin() + kCommonHeadersSize, net_data.end() });
+
+    REQUIRE_EQ(decoded.entries.size(), 2);
+
+    CHECK_EQ(decoded.entries[0].type, MsgType::kNodeInfoAdvertise);
+    NodeInfo decoded_ni(decoded.entries[0].data);
+    CHECK_EQ(decoded_ni.id, node_info.id);
+    CHECK_EQ(decoded_ni.contact, node_info.contact);
+
+    CHECK_EQ(decoded.entries[1].type, MsgType::kAnnounceInfoAdvertised);
+    AnnounceInfo decoded_ai(decoded.entries[1].data);
+    CHECK_EQ(decoded_ai.source_node_id, announce_info.source_node_id);
+    CHECK_EQ(decoded_ai.fullname_hash, announce_info.fullname_hash);
+    CHECK(decoded_ai.name_space == announce_info.name_space);
+
+    bulk_sync.Clear();
+    CHECK_EQ(bulk_sync.NumEntries(), 0);
+    CHECK_EQ(bulk_sync.SizeBytes(), 0);
+}
+
+TEST_CASE("Bulk Sync truncated entry")
+{
+    using namespace laps::peering;
+
+    AnnounceInfo announce_info;
+    announce_info.name_space = quicr::messages::TrackNamespace{ "abc"s };
+
+    BulkSync bulk_sync;
+    bulk_sync.Add(MsgType::kAnnounceInfoAdvertised, announce_info);
+
+    auto net_data = bulk_sync.Serialize(false);
+    net_data.pop_back();
+
+    CHECK_THROWS_AS(BulkSync(std::span<uint8_t const>(net_data)), std::invalid_argument);
+}
@@ -24,6 +24,7 @@ TEST_CASE("Serialize Connect")
 
     CHECK_EQ(net_data.size(), connect.SizeBytes() + kCommonHeadersSize);
     CHECK_EQ(net_data.size(), 80);
+    CHECK_EQ(net_data.front(), kProtocolVersion);
 
     Connect decoded_c({ net_data.begin() + kCommonHeadersSize, net_data.end() });
 
@@ -68,6 +69,19 @@ TEST_CASE("Serialize Connect Response")
     CHECK_EQ(connect_resp.node_info->latitude, decoded_cr.node_info->latitude);
 }
 
+TEST_CASE("Serialize Connect Response negotiated version")
+{
+    using namespace laps::peering;
+
+    ConnectResponse connect_resp;
+    connect_resp.version = kProtocolVersionMin;
+    connect_resp.error = ProtocolError::kConnectError;
+
+    auto net_data = connect_resp.Serialize();
+
+    CHECK_EQ(net_data.front(), kProtocolVersionMin);
+}
+
 TEST_CASE("Serialize Connect Response With Error")
 {
     using namespace laps::peering;
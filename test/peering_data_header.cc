@@ -66,3 +66,92 @@ TEST_CASE("Serialize Data Header existing stream")
     // Existing stream type produces no serialized data
     CHECK_EQ(net_data.size(), 0);
 }
+
+TEST_CASE("Serialize Data Header compact datagram")
+{
+    DataHeader data_hdr;
+    data_hdr.type = DataType::kDatagram;
+    data_hdr.compact = true;
+    data_hdr.sns_id = 0x1234;
+    data_hdr.track_full_name_hash = 0xabcdef0123456789;
+
+    auto net_data = data_hdr.Serialize();
+
+    // header len, type, 2 byte var-int SNS ID and 8 byte hash
+    CHECK_EQ(net_data.size(), 12);
+    CHECK_EQ(net_data.size(), net_data.front());
+
+    DataHeader decoded(net_data);
+
+    CHECK(decoded.compact);
+    CHECK_FALSE(decoded.implicit_track);
+    CHECK_EQ(data_hdr.type, decoded.type);
+    CHECK_EQ(data_hdr.sns_id, decoded.sns_id);
+    CHECK_EQ(data_hdr.track_full_name_hash, decoded.track_full_name_hash);
+}
+
+TEST_CASE("Serialize Data Header compact new stream with implicit track")
+{
+    DataHeader data_header;
+    data_header.type = DataType::kNewStream;
+    data_header.compact = true;
+    data_header.implicit_track = true;
+    data_header.sns_id = 10;
+    data_header.priority = 100;
+    data_header.ttl = 5000;
+    data_header.track_full_name_hash = 0xabcdef;
+
+    auto net_data = data_header.Serialize();
+
+    // header len, type, 1 byte var-int SNS ID, priority and 2 byte var-int TTL
+    CHECK_EQ(net_data.size(), 6);
+    CHECK_EQ(net_data.size(), data_header.SizeBytes());
+
+    DataHeader decoded(net_data);
+
+    CHECK(decoded.compact);
+    CHECK(decoded.implicit_track);
+    CHECK_EQ(data_header.type, decoded.type);
+    CHECK_EQ(data_header.sns_id, decoded.sns_id);
+    CHECK_EQ(decoded.track_full_name_hash, 0);
+    CHECK_EQ(data_header.priority, decoded.priority);
+    CHECK_EQ(data_header.ttl, decoded.ttl);
+}
+
+TEST_CASE("Deserialize Data Header rejects short and truncated input")
+{
+    DataHeader data_header;
+    data_header.type = DataType::kNewStream;
+    data_header.compact = true;
+    data_header.sns_id = 0x1234;
+    data_header.ttl = 5000;
+    data_header.track_full_name_hash = 0xabcdef0123456789;
+
+    const auto net_data = data_header.Serialize();
+
+    DataHeader decoded;
+    CHECK(decoded.Deserialize(net_data));
+
+    // Empty input and header length longer than the data
+    CHECK_FALSE(decoded.Deserialize({}));
+    CHECK_FALSE(decoded.Deserialize(std::span(net_data).first(net_data.size() - 1)));
+
+    // Header length that does not cover the fields, for every truncated length
+    for (uint8_t len = 0; len < net_data.size(); len++) {
+        auto truncated = net_data;
+        truncated[0] = len;
+        CHECK_FALSE(decoded.Deserialize(truncated));
+    }
+
+    // Var-int length past the header length
+    std::vector<uint8_t> bad_uintvar{ 3, static_cast<uint8_t>(DataType::kDatagram) | kDataFlagCompact, 0xC0 };
+    CHECK_FALSE(decoded.Deserialize(bad_uintvar));
+
+    // Non-compact header length that does not cover the fields
+    data_header.compact = false;
+    auto legacy_data = data_header.Serialize();
+    legacy_data[0] = 10;
+    CHECK_FALSE(decoded.Deserialize(legacy_data));
+
+    CHECK_THROWS_AS(DataHeader(std::span(net_data).first(3)), std::invalid_argument);
+}
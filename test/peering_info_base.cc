@@ -1,8 +1,11 @@
 
 #include <doctest/doctest.h>
+#include <cstddef>
 #include <random>
 
+#include "config.h"
 #include "peering/info_base.h"
+#include "peering/peer_manager.h"
 
 using namespace std::string_literals;
 
@@ -23,6 +26,24 @@ GenerateFullTrackNames(int count)
     return full_names;
 }
 
+/*
+ * Peer sessions for node selection only. They are never connected, so the peer manager they reference is not used
+ * and is not constructed.
+ */
+std::shared_ptr<laps::peering::PeerSession>
+MakePeerSession(quicr::TransportConnId conn_id)
+{
+    static const laps::Config config;
+    alignas(laps::peering::PeerManager) static std::byte manager[sizeof(laps::peering::PeerManager)];
+
+    return std::make_shared<laps::peering::PeerSession>(true,
+                                                        conn_id,
+                                                        config,
+                                                        laps::peering::NodeInfo{},
+                                                        quicr::TransportRemote{},
+                                                        *reinterpret_cast<laps::peering::PeerManager*>(manager));
+}
+
 TEST_CASE("Add/Remove Announces")
 {
     using namespace laps::peering;
@@ -134,3 +155,266 @@ TEST_CASE("Prefix match announces")
     result = ib->GetAnnounceIds(ns4, {}, false);
     CHECK_EQ(result.size(), 1);
 }
+
+TEST_CASE("Prefix match subscribes")
+{
+    using namespace laps::peering;
+
+    const auto full_names = GenerateFullTrackNames(30);
+    std::shared_ptr<InfoBase> ib = std::make_shared<InfoBase>();
+
+    std::vector<SubscribeInfo> subscribes;
+    uint64_t request_id{ 0 };
+
+    // Add to info base
+    for (const auto& fn : full_names) {
+        SubscribeInfo si;
+        si.track_hash = quicr::TrackHash(fn);
+        si.source_node_id = 0x12345678;
+
+        const auto sub_data = quicr::messages::Message()
+                                .Append(++request_id)
+                                .Append(fn.name_space)
+                                .Append(fn.name)
+                                .Append(quicr::messages::Parameters{});
+        si.SetSubscribeData(sub_data.ToByteSpan());
+
+        ib->AddSubscribe(si);
+        subscribes.push_back(si);
+    }
+
+    const auto ns1 =
+      quicr::messages::TrackNamespace{ "first"s, "second"s, "third"s, "final namespace tuple"s, "invalid"s };
+    const auto ns2 = quicr::messages::TrackNamespace{ "first"s, "second"s, "third"s };
+    const auto ns3 = quicr::messages::TrackNamespace{ "other"s };
+
+    CHECK_EQ(ib->GetPrefixMatchingSubscribes(ns1).size(), 0);
+    CHECK_EQ(ib->GetPrefixMatchingSubscribes(ns2).size(), full_names.size());
+    CHECK_EQ(ib->GetPrefixMatchingSubscribes(ns3).size(), 0);
+
+    // Longer namespace matches the shorter subscribe namespace
+    const auto& first_name = full_names.front().name;
+    const auto last_tuple = "r=" + std::string(first_name.begin(), first_name.end());
+    const auto ns4 =
+      quicr::messages::TrackNamespace{ "first"s, "second"s, "third"s, "final namespace tuple"s, last_tuple, "x"s };
+    CHECK_EQ(ib->GetPrefixMatchingSubscribes(ns4).size(), 1);
+
+    for (const auto& si : subscribes) {
+        ib->RemoveSubscribe(si);
+    }
+
+    CHECK_EQ(ib->GetPrefixMatchingSubscribes(ns2).size(), 0);
+    CHECK(ib->prefix_lookup_subscribes_.empty());
+    CHECK(ib->namespace_lookup_subscribes_.empty());
+}
+
+TEST_CASE("Client stream keys do not alias large subgroups")
+{
+    using namespace laps::peering;
+
+    InfoBase::FibEntry entry;
+
+    // Previous key of group << 16 | uint16(subgroup) aliased all of these into the same stream
+    entry.client_streams.try_emplace({ 1, 1, 0 }, 100);
+    entry.client_streams.try_emplace({ 1, 1, 0x10000 }, 101);
+    entry.client_streams.try_emplace({ 1, 0, 0x10000 }, 102);
+    entry.client_streams.try_emplace({ 1, 1ULL << 48, 0 }, 103);
+
+    CHECK_EQ(entry.client_streams.size(), 4);
+    CHECK_EQ(entry.client_streams.at({ 1, 1, 0 }), 100);
+    CHECK_EQ(entry.client_streams.at({ 1, 1, 0x10000 }), 101);
+    CHECK_EQ(entry.client_streams.at({ 1, 0, 0x10000 }), 102);
+    CHECK_EQ(entry.client_streams.at({ 1, 1ULL << 48, 0 }), 103);
+}
+
+TEST_CASE("Client stream end and close only affect the matching connection")
+{
+    using namespace laps::peering;
+
+    InfoBase::FibEntry entry;
+
+    // Two client publishers of the same track using the same group and subgroup
+    entry.client_streams.try_emplace({ 10, 5, 2 }, 100);
+    entry.client_streams.try_emplace({ 11, 5, 2 }, 101);
+    CHECK_EQ(entry.client_streams.size(), 2);
+
+    // End subgroup of connection 10
+    CHECK_EQ(entry.EraseClientStream({ 10, 5, 2 }), 100);
+    CHECK_FALSE(entry.EraseClientStream({ 10, 5, 2 }).has_value());
+    CHECK_FALSE(entry.client_streams.contains({ 10, 5, 2 }));
+    CHECK_EQ(entry.client_streams.at({ 11, 5, 2 }), 101);
+
+    // Unknown connection does not close anything
+    CHECK_FALSE(entry.EraseClientStream({ 12, 5, 2 }).has_value());
+    CHECK_EQ(entry.client_streams.size(), 1);
+
+    // Peer closed egress stream only removes the stream using that egress stream id
+    entry.client_streams.try_emplace({ 10, 6, 0 }, 102);
+    CHECK_FALSE(entry.EraseClientStreamById(100));
+    CHECK(entry.EraseClientStreamById(102));
+    CHECK_EQ(entry.client_streams.size(), 1);
+    CHECK_EQ(entry.client_streams.at({ 11, 5, 2 }), 101);
+}
+
+TEST_CASE("Peer FIB version is per ingress SNS")
+{
+    using namespace laps::peering;
+
+    std::shared_ptr<InfoBase> ib = std::make_shared<InfoBase>();
+
+    const auto sns_1 = ib->GetPeerFibVersion(1, 10);
+    const auto sns_2 = ib->GetPeerFibVersion(1, 11);
+    const auto other_peer = ib->GetPeerFibVersion(2, 10);
+
+    CHECK_EQ(ib->GetPeerFibVersion(1, 10), sns_1);
+    CHECK_EQ(sns_1->load(), 0);
+
+    // Change of one SNS does not change the others
+    ib->PeerFibChanged(1, 10);
+    CHECK_EQ(sns_1->load(), 1);
+    CHECK_EQ(sns_2->load(), 0);
+    CHECK_EQ(other_peer->load(), 0);
+
+    // Removed entry changes the version and a new version is tracked afterwards
+    ib->PeerFibChanged(1, 11, true);
+    CHECK_EQ(sns_2->load(), 1);
+    CHECK_NE(ib->GetPeerFibVersion(1, 11), sns_2);
+
+    // Purge changes all versions of the peer session only
+    ib->PurgePeerSessionInfo(1);
+    CHECK_EQ(sns_1->load(), 2);
+    CHECK_EQ(other_peer->load(), 0);
+}
+
+TEST_CASE("Node load and sRTT refresh is not a topology change")
+{
+    using namespace laps::peering;
+
+    NodeInfo current;
+    current.id = 1;
+    current.type = NodeType::kEdge;
+    current.contact = "relay-1:33435";
+    current.path = { { 2, 1000 }, { 3, 2000 } };
+
+    auto update = current;
+    update.load.cpu_pct = 50;
+    update.load.egress_kbps = 1000;
+    update.path = { { 2, 1500 }, { 3, 2500 } };
+    CHECK_FALSE(InfoBase::IsTopologyChange(current, update));
+
+    update.path = { { 2, 1500 }, { 4, 2500 } };
+    CHECK(InfoBase::IsTopologyChange(current, update));
+
+    update.path = { { 2, 1500 } };
+    CHECK(InfoBase::IsTopologyChange(current, update));
+
+    update = current;
+    update.contact = "relay-1:33436";
+    CHECK(InfoBase::IsTopologyChange(current, update));
+}
+
+TEST_CASE("Announce sync log resume")
+{
+    using namespace laps::peering;
+
+    const auto full_names = GenerateFullTrackNames(3);
+    std::shared_ptr<InfoBase> ib = std::make_shared<InfoBase>();
+
+    CHECK_NE(ib->sync_epoch_, 0);
+
+    std::vector<AnnounceInfo> announces;
+    for (const auto& fn : full_names) {
+        AnnounceInfo ai;
+        ai.fullname_hash = quicr::TrackHash(fn).track_fullname_hash;
+        ai.name_space = fn.name_space, ai.name = fn.name;
+        ai.source_node_id = 0x12345678;
+
+        ib->AddAnnounce(ai);
+        announces.push_back(ai);
+    }
+
+    const auto synced_version = ib->announces_sync_log_.version;
+    CHECK_EQ(synced_version, 3);
+    CHECK(ib->announces_sync_log_.CanResume(synced_version));
+    CHECK(ib->announces_sync_log_.ChangesSince(synced_version).empty());
+
+    ib->AddAnnounce(announces.front()); // Existing, not a change
+    ib->RemoveAnnounce(announces.back());
+
+    CHECK_EQ(ib->announces_sync_log_.version, 4);
+    CHECK(ib->announces_sync_log_.CanResume(synced_version));
+
+    const auto changes = ib->announces_sync_log_.ChangesSince(synced_version);
+    REQUIRE_EQ(changes.size(), 1);
+    CHECK(changes.front().withdraw);
+    CHECK_EQ(changes.front().info.fullname_hash, announces.back().fullname_hash);
+
+    // Version from the future (e.g., previous epoch) cannot be resumed
+    CHECK_FALSE(ib->announces_sync_log_.CanResume(synced_version + 10));
+
+    ib->ClearAnnounces();
+    CHECK(ib->announces_.empty());
+    CHECK_FALSE(ib->announces_sync_log_.CanResume(synced_version));
+}
+
+TEST_CASE("Equal cost path add and remove changes the multipath peer sessions")
+{
+    using namespace laps::peering;
+
+    std::shared_ptr<InfoBase> ib = std::make_shared<InfoBase>();
+    ib->SetMultipath(2, 100);
+
+    const auto peer_1 = MakePeerSession(1);
+    const auto peer_2 = MakePeerSession(2);
+
+    NodeInfo via_1;
+    via_1.id = 100;
+    via_1.path = { { 11, 1000 } };
+
+    auto via_2 = via_1;
+    via_2.path = { { 12, 5000 } };
+
+    auto changes = ib->AddNode(peer_1, via_1);
+    REQUIRE_EQ(changes.size(), 1);
+    CHECK_FALSE(changes.front().prev_peer_session_id.has_value());
+    CHECK_EQ(changes.front().peer_session_id, 1);
+
+    // Path that is not equal cost does not change the paths of the node
+    CHECK(ib->AddNode(peer_2, via_2).empty());
+    CHECK_FALSE(ib->nodes_multipath_.contains(via_1.id));
+
+    // sRTT within the margin of the best makes the path equal cost, the best does not change
+    via_2.path = { { 12, 1050 } };
+    changes = ib->AddNode(peer_2, via_2);
+    REQUIRE_EQ(changes.size(), 1);
+    CHECK_EQ(changes.front().node_id, via_1.id);
+    CHECK_EQ(changes.front().prev_peer_session_id, 1);
+    CHECK_EQ(changes.front().peer_session_id, 1);
+    CHECK_FALSE(changes.front().BestChanged());
+    REQUIRE(ib->nodes_multipath_.contains(via_1.id));
+    CHECK_EQ(ib->nodes_multipath_.at(via_1.id).size(), 2);
+
+    // Flows are split across the equal cost peer sessions
+    std::size_t via_2_flows{ 0 };
+    for (uint64_t flow_hash = 0; flow_hash < 100; ++flow_hash) {
+        const auto peer_session = ib->GetPeerSessionForFlow(via_1.id, flow_hash).lock();
+        REQUIRE(peer_session != nullptr);
+        via_2_flows += peer_session == peer_2;
+    }
+    CHECK_GT(via_2_flows, 0);
+    CHECK_LT(via_2_flows, 100);
+
+    // Refresh that keeps the paths the same is not a change
+    CHECK(ib->AddNode(peer_2, via_2).empty());
+
+    // Removed equal cost path moves its flows back to the best
+    changes = ib->RemoveNode(2, via_1.id);
+    REQUIRE_EQ(changes.size(), 1);
+    CHECK_EQ(changes.front().prev_peer_session_id, 1);
+    CHECK_EQ(changes.front().peer_session_id, 1);
+    CHECK_FALSE(ib->nodes_multipath_.contains(via_1.id));
+
+    for (uint64_t flow_hash = 0; flow_hash < 100; ++flow_hash) {
+        CHECK_EQ(ib->GetPeerSessionForFlow(via_1.id, flow_hash).lock(), peer_1);
+    }
+}
@@ -55,4 +55,38 @@ TEST_CASE("Serialize Node Info")
         CHECK_EQ(ni.path.at(i).id, decoded_ni.path.at(i).id);
         CHECK_EQ(ni.path.at(i).srtt_us, decoded_ni.path.at(i).srtt_us);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("Serialize Node Info with load")
+{
+    using namespace laps::peering;
+
+    NodeInfo ni;
+
+    ni.type = NodeType::kVia;
+    ni.id = NodeId().Value("12:34");
+    ni.contact = "localhost:1234";
+    ni.load = { 95, 250'000, 1234 };
+    ni.with_load = true;
+
+    ni.path.push_back({ NodeId().Value("1:1"), 54321 });
+
+    auto net_data = ni.Serialize();
+
+    CHECK_EQ(net_data.size(), ni.SizeBytes());
+
+    NodeInfo decoded_ni(net_data, true);
+
+    CHECK_EQ(ni.contact, decoded_ni.contact);
+    CHECK(ni.load == decoded_ni.load);
+    CHECK(decoded_ni.load.Overloaded());
+    REQUIRE_EQ(decoded_ni.path.size(), 1);
+    CHECK_EQ(ni.path.front().srtt_us, decoded_ni.path.front().srtt_us);
+
+    // Peers before load support do not encode or decode load
+    ni.with_load = false;
+    NodeInfo legacy_ni(ni.Serialize());
+
+    CHECK_EQ(legacy_ni.load.cpu_pct, 0);
+    REQUIRE_EQ(legacy_ni.path.size(), 1);
+    CHECK_EQ(ni.path.front().id, legacy_ni.path.front().id);
+}
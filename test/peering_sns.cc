@@ -28,4 +28,26 @@ TEST_CASE("Serialize Subscribe Node Set")
     CHECK_EQ(sns.nodes.size(), decoded.nodes.size());
 
     CHECK_EQ(*sns.nodes.begin(), *decoded.nodes.begin());
-}
\ No newline at end of file
+}
+TEST_CASE("Serialize Subscribe Node Set with track")
+{
+    using namespace laps::peering;
+
+    SubscribeNodeSet sns;
+
+    sns.id = 0x1234;
+    sns.priority = 127;
+    sns.nodes.emplace(NodeId().Value("1:1"));
+    sns.track_fullname_hash = 0xabcdef0123456789;
+
+    auto net_data = sns.Serialize(false);
+
+    CHECK_EQ(net_data.size(), 23);
+    CHECK_EQ(net_data.size(), sns.SizeBytes(false));
+
+    SubscribeNodeSet decoded(net_data);
+
+    CHECK_EQ(sns.id, decoded.id);
+    CHECK_EQ(sns.nodes.size(), decoded.nodes.size());
+    CHECK_EQ(sns.track_fullname_hash, decoded.track_fullname_hash);
+}
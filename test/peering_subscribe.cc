@@ -3,6 +3,9 @@
 #include "peering/messages/subscribe_info.h"
 
 #include <iostream>
+#include <optional>
+
+using namespace std::string_literals;
 
 TEST_CASE("Serialize Subscribe Info")
 {
@@ -31,3 +34,117 @@ TEST_CASE("Serialize Subscribe Info")
     CHECK_EQ(subscribe_info.track_hash.track_name_hash, decoded_si.track_hash.track_name_hash);
     CHECK_EQ(subscribe_info.track_hash.track_fullname_hash, decoded_si.track_hash.track_fullname_hash);
 }
+
+TEST_CASE("Subscribe Info decoded view")
+{
+    using namespace laps::peering;
+
+    const auto track_namespace = quicr::messages::TrackNamespace{ "abc"s, "12345"s };
+    const auto track_name = quicr::Bytes{ 'n', 'a', 'm', 'e' };
+
+    quicr::messages::Parameters parameters;
+    parameters.Add(quicr::messages::ParameterType::kSubscriberPriority, uint8_t(5));
+
+    auto sub_data =
+      quicr::messages::Message().Append(uint64_t(7)).Append(track_namespace).Append(track_name).Append(parameters);
+
+    SubscribeInfo subscribe_info;
+    subscribe_info.SetSubscribeData(sub_data.ToByteSpan());
+
+    const auto& view = subscribe_info.View();
+    CHECK_EQ(view.request_id, 7);
+    CHECK_EQ(view.track_namespace, track_namespace);
+    CHECK_EQ(view.track_name, track_name);
+    CHECK_EQ(view.priority, 5);
+    CHECK_FALSE(view.has_new_group_request);
+
+    // Decoded view is shared by copies
+    SubscribeInfo copy_si = subscribe_info;
+    CHECK_EQ(&copy_si.View(), &subscribe_info.View());
+
+    // Deserialized subscribe info is decoded
+    SubscribeInfo decoded_si(subscribe_info.Serialize(false));
+    CHECK_EQ(decoded_si.SubscribeData(), subscribe_info.SubscribeData());
+    CHECK_EQ(decoded_si.View().request_id, 7);
+    CHECK_EQ(decoded_si.View().priority, 5);
+
+    // Setting subscribe data decodes the new data
+    parameters.Add(quicr::messages::ParameterType::kNewGroupRequest, uint64_t(3));
+    sub_data =
+      quicr::messages::Message().Append(uint64_t(8)).Append(track_namespace).Append(track_name).Append(parameters);
+    copy_si.SetSubscribeData(sub_data.ToByteSpan());
+
+    CHECK_EQ(copy_si.View().request_id, 8);
+    CHECK(copy_si.View().has_new_group_request);
+    CHECK_EQ(subscribe_info.View().request_id, 7);
+}
+
+TEST_CASE("Subscribe Info without subscribe data")
+{
+    using namespace laps::peering;
+
+    SubscribeInfo subscribe_info;
+    CHECK(subscribe_info.SubscribeData().empty());
+    CHECK_THROWS_AS(subscribe_info.View(), std::logic_error);
+
+    // Deserialized subscribe info without subscribe data has no view
+    SubscribeInfo decoded_si(subscribe_info.Serialize(false));
+    CHECK(decoded_si.SubscribeData().empty());
+    CHECK_THROWS_AS(decoded_si.View(), std::logic_error);
+}
+
+TEST_CASE("Subscribe Info with subscribe data that cannot be decoded")
+{
+    using namespace laps::peering;
+
+    // Subscriber priority parameter is missing
+    auto sub_data = quicr::messages::Message()
+                      .Append(uint64_t(7))
+                      .Append(quicr::messages::TrackNamespace{ "abc"s, "12345"s })
+                      .Append(quicr::Bytes{ 'n', 'a', 'm', 'e' })
+                      .Append(quicr::messages::Parameters{});
+
+    SubscribeInfo subscribe_info;
+    CHECK_NOTHROW(subscribe_info.SetSubscribeData(sub_data.ToByteSpan()));
+    CHECK_FALSE(subscribe_info.SubscribeData().empty());
+    CHECK_THROWS_AS(subscribe_info.View(), std::logic_error);
+
+    // Still deserialized and forwarded as received
+    std::optional<SubscribeInfo> decoded_si;
+    CHECK_NOTHROW(decoded_si.emplace(subscribe_info.Serialize(false)));
+    REQUIRE(decoded_si.has_value());
+    CHECK_EQ(decoded_si->SubscribeData(), subscribe_info.SubscribeData());
+    CHECK_THROWS_AS(decoded_si->View(), std::logic_error);
+}
+
+TEST_CASE("Subscribe Info same subscribe ignores the request id")
+{
+    using namespace laps::peering;
+
+    const auto track_namespace = quicr::messages::TrackNamespace{ "abc"s, "12345"s };
+    const auto track_name = quicr::Bytes{ 'n', 'a', 'm', 'e' };
+
+    const auto make_subscribe = [&](uint64_t request_id, uint8_t priority) {
+        quicr::messages::Parameters parameters;
+        parameters.Add(quicr::messages::ParameterType::kSubscriberPriority, priority);
+
+        auto sub_data = quicr::messages::Message()
+                          .Append(request_id)
+                          .Append(track_namespace)
+                          .Append(track_name)
+                          .Append(parameters);
+
+        SubscribeInfo subscribe_info;
+        subscribe_info.SetSubscribeData(sub_data.ToByteSpan());
+        return subscribe_info;
+    };
+
+    const auto subscribe_info = make_subscribe(7, 5);
+
+    // Request id of different encoded size
+    CHECK(subscribe_info.SameSubscribe(make_subscribe(100000, 5)));
+    CHECK_FALSE(subscribe_info.SubscribeData() == make_subscribe(100000, 5).SubscribeData());
+
+    CHECK_FALSE(subscribe_info.SameSubscribe(make_subscribe(8, 6)));
+    CHECK_FALSE(subscribe_info.SameSubscribe(SubscribeInfo{}));
+}
@@ -0,0 +1,36 @@
+#include <doctest/doctest.h>
+
+#include "peering/messages/sync_state.h"
+
+TEST_CASE("Serialize Sync State")
+{
+    using namespace laps::peering;
+
+    SyncState sync_state;
+    sync_state.epoch = 0xfedcba9876543210;
+    sync_state.nodes_version = 10;
+    sync_state.announces_version = 1'000;
+    sync_state.subscribes_version = 500'000;
+    sync_state.flags = kSyncFlagNodesResumed | kSyncFlagSubscribesResumed | kSyncFlagDone;
+
+    auto net_data = sync_state.Serialize(false);
+
+    CHECK_EQ(net_data.size(), 16);
+    CHECK_EQ(net_data.size(), sync_state.SizeBytes());
+
+    SyncState decoded(net_data);
+
+    CHECK_EQ(decoded.epoch, sync_state.epoch);
+    CHECK_EQ(decoded.nodes_version, sync_state.nodes_version);
+    CHECK_EQ(decoded.announces_version, sync_state.announces_version);
+    CHECK_EQ(decoded.subscribes_version, sync_state.subscribes_version);
+    CHECK_EQ(decoded.flags, sync_state.flags);
+
+    auto request_data = sync_state.Serialize(true, true);
+    CHECK_EQ(request_data.size(), kCommonHeadersSize + 16);
+    CHECK_EQ(ValueOf<uint16_t>({ request_data.begin() + 1, request_data.begin() + 3 }),
+             static_cast<uint16_t>(MsgType::kSyncRequest));
+
+    net_data.pop_back();
+    CHECK_THROWS(SyncState(std::span<uint8_t const>(net_data)));
+}
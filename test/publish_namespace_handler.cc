@@ -0,0 +1,334 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "publish_namespace_handler.h"
+#include "ranking_sim.h"
+#include "track_ranking.h"
+
+using namespace std::string_literals;
+
+namespace laps {
+    namespace {
+        constexpr uint64_t kProperty = 0x10;
+        constexpr uint64_t kPublisherConnId = 1;
+
+        const quicr::TrackNamespace kNamespace{ "test"s, "ranking"s };
+
+        std::shared_ptr<sim::SimPublishTrackHandler> MakeTrack(uint64_t index)
+        {
+            const auto name = "track-" + std::to_string(index);
+            return std::make_shared<sim::SimPublishTrackHandler>(
+              quicr::FullTrackName{ kNamespace, { name.begin(), name.end() } });
+        }
+
+        /**
+         * @brief Create a handler with the tracks published and paused, same as the relay namespace publish flow
+         */
+        std::shared_ptr<PublishNamespaceHandler> MakeHandler(
+          std::shared_ptr<sim::SimTickService> tick_service,
+          uint64_t max_selected,
+          const std::vector<std::shared_ptr<sim::SimPublishTrackHandler>>& tracks)
+        {
+            auto handler = PublishNamespaceHandler::Create(kNamespace, tick_service);
+            handler->SetMaxSelected(max_selected);
+            handler->SetPropertyType(kProperty);
+
+            for (const auto& track : tracks) {
+                handler->PublishTrack(track);
+                track->Pause();
+            }
+
+            return handler;
+        }
+
+        using RankedTrack = std::pair<std::shared_ptr<sim::SimPublishTrackHandler>, uint64_t>;
+
+        /**
+         * @brief Update the handler with the selected candidate tracks and values in rank order
+         *
+         * @param changed           False to notify the same selected candidates without a change
+         */
+        void Rank(PublishNamespaceHandler& handler, const std::vector<RankedTrack>& ranked, bool changed = true)
+        {
+            std::vector<TrackRankingDelta::SelectedTrack> selected;
+            TrackRankingDelta delta;
+            delta.property_type = kProperty;
+
+            for (const auto& [track, value] : ranked) {
+                const auto track_alias = track->GetTrackAlias().value();
+                selected.emplace_back(track_alias, selected.size(), 0, kPublisherConnId, value);
+                if (changed) {
+                    delta.rank_changed.push_back(track_alias);
+                }
+            }
+
+            delta.selected = selected;
+            handler.UpdateTrackRanking(delta);
+        }
+
+        bool IsSelected(const std::shared_ptr<sim::SimPublishTrackHandler>& track)
+        {
+            return track->GetStatus() == quicr::PublishTrackHandler::Status::kOk;
+        }
+    }
+
+    TEST_SUITE("PublishNamespaceHandler")
+    {
+        TEST_CASE("Ranking updates concurrent with publish and forward")
+        {
+            constexpr uint64_t kTracks = 200;
+
+            auto tick_service = std::make_shared<sim::SimTickService>();
+            auto ranking = std::make_shared<TrackRanking>();
+            auto handler = PublishNamespaceHandler::Create(kNamespace, tick_service);
+            handler->SetMaxSelected(2);
+            handler->SetPropertyType(kProperty);
+            ranking->AddNamespaceHandler(handler);
+
+            std::vector<std::shared_ptr<sim::SimPublishTrackHandler>> tracks;
+            for (uint64_t i = 0; i < kTracks; ++i) {
+                tracks.push_back(MakeTrack(i));
+            }
+
+            // Transport thread publishes tracks and forwards data while the ranking updates the top-n
+            std::thread transport([&] {
+                const auto data = std::make_shared<const std::vector<uint8_t>>(16, 0);
+                for (uint64_t i = 0; i < kTracks; ++i) {
+                    tracks[i]->Pause();
+                    handler->PublishTrack(tracks[i]);
+
+                    // Not published by the handler, only looked up
+                    const auto unpublished = MakeTrack(kTracks + i);
+                    handler->ForwardPublishedData(unpublished->GetTrackAlias().value(), true, 0, 0, data);
+                }
+            });
+
+            for (uint64_t n = 0; n < kTracks * 4; ++n) {
+                tick_service->Set(n);
+                ranking->UpdateValue(
+                  tracks[n % kTracks]->GetTrackAlias().value(), kProperty, (n * 7919) % 100, n, kPublisherConnId);
+            }
+
+            transport.join();
+
+            // Paused tracks are unpublished only after the publish done delay
+            CHECK_EQ(handler->GetPublishedCount(), kTracks);
+            CHECK_EQ(handler->GetUnpublishedCount(), 0);
+        }
+
+        TEST_CASE("Switch suppressed by hysteresis margin")
+        {
+            auto tick_service = std::make_shared<sim::SimTickService>();
+            const auto a = MakeTrack(1);
+            const auto b = MakeTrack(2);
+            auto handler = MakeHandler(tick_service, 1, { a, b });
+            handler->SetHysteresis(10);
+
+            Rank(*handler, { { a, 50 }, { b, 40 } });
+            CHECK(IsSelected(a));
+            CHECK_FALSE(IsSelected(b));
+
+            // Within the margin of the selected track
+            Rank(*handler, { { b, 55 }, { a, 50 } });
+            CHECK(IsSelected(a));
+            CHECK_FALSE(IsSelected(b));
+            CHECK_EQ(handler->GetSwitchMetrics().avoided_hysteresis, 1);
+            CHECK_EQ(handler->GetSwitchMetrics().switches, 0);
+
+            // Suppressed switch is not evaluated again until the candidates change
+            Rank(*handler, { { b, 55 }, { a, 50 } }, false);
+            CHECK_EQ(handler->GetSwitchMetrics().avoided_hysteresis, 1);
+
+            // Exceeds the margin
+            Rank(*handler, { { b, 61 }, { a, 50 } });
+            CHECK(IsSelected(b));
+            CHECK_FALSE(IsSelected(a));
+            CHECK_EQ(handler->GetSwitchMetrics().avoided_hysteresis, 1);
+            CHECK_EQ(handler->GetSwitchMetrics().switches, 1);
+        }
+
+        TEST_CASE("Switch blocked by min dwell and allowed after dwell")
+        {
+            auto tick_service = std::make_shared<sim::SimTickService>();
+            const auto a = MakeTrack(1);
+            const auto b = MakeTrack(2);
+            auto handler = MakeHandler(tick_service, 1, { a, b });
+            handler->SetMinDwell(100);
+
+            Rank(*handler, { { a, 50 }, { b, 40 } });
+            CHECK(IsSelected(a));
+
+            tick_service->Set(50);
+            Rank(*handler, { { b, 60 }, { a, 50 } });
+            CHECK(IsSelected(a));
+            CHECK_FALSE(IsSelected(b));
+            CHECK_EQ(handler->GetSwitchMetrics().avoided_dwell, 1);
+            CHECK_EQ(handler->GetSwitchMetrics().switches, 0);
+
+            // Blocked switch is evaluated again without a change of the candidates
+            tick_service->Set(99);
+            Rank(*handler, { { b, 60 }, { a, 50 } }, false);
+            CHECK(IsSelected(a));
+            CHECK_EQ(handler->GetSwitchMetrics().avoided_dwell, 2);
+
+            tick_service->Set(100);
+            Rank(*handler, { { b, 60 }, { a, 50 } }, false);
+            CHECK(IsSelected(b));
+            CHECK_FALSE(IsSelected(a));
+            CHECK_EQ(handler->GetSwitchMetrics().avoided_dwell, 2);
+            CHECK_EQ(handler->GetSwitchMetrics().switches, 1);
+
+            // Nothing blocked, unchanged candidates are not evaluated again
+            tick_service->Set(150);
+            Rank(*handler, { { a, 70 }, { b, 60 } }, false);
+            CHECK(IsSelected(b));
+            CHECK_EQ(handler->GetSwitchMetrics().avoided_dwell, 2);
+        }
+
+        TEST_CASE("Incumbent that drops out of the candidates is replaced")
+        {
+            auto tick_service = std::make_shared<sim::SimTickService>();
+            const auto a = MakeTrack(1);
+            const auto b = MakeTrack(2);
+            const auto c = MakeTrack(3);
+            auto handler = MakeHandler(tick_service, 2, { a, b, c });
+            handler->SetHysteresis(10);
+            handler->SetMinDwell(100);
+
+            Rank(*handler, { { a, 50 }, { b, 40 }, { c, 30 } });
+            CHECK(IsSelected(a));
+            CHECK(IsSelected(b));
+            CHECK_FALSE(IsSelected(c));
+
+            // Neither hysteresis nor min dwell hold a track that is no longer a candidate
+            tick_service->Set(10);
+            Rank(*handler, { { a, 50 }, { c, 30 } });
+            CHECK(IsSelected(a));
+            CHECK(IsSelected(c));
+            CHECK_FALSE(IsSelected(b));
+
+            const auto metrics = handler->GetSwitchMetrics();
+            CHECK_EQ(metrics.switches, 1);
+            CHECK_EQ(metrics.avoided_hysteresis, 0);
+            CHECK_EQ(metrics.avoided_dwell, 0);
+        }
+
+        TEST_CASE("Demoted track is unpublished after the publish done delay and reused")
+        {
+            auto tick_service = std::make_shared<sim::SimTickService>();
+            const auto a = MakeTrack(1);
+            const auto b = MakeTrack(2);
+            auto handler = MakeHandler(tick_service, 1, { a, b });
+
+            std::size_t factory_calls{ 0 };
+            handler->SetPublishTrackFactory([&](quicr::messages::TrackAlias, uint64_t) {
+                factory_calls++;
+                return nullptr;
+            });
+
+            Rank(*handler, { { a, 50 }, { b, 40 } });
+
+            tick_service->Set(1000);
+            Rank(*handler, { { b, 60 }, { a, 50 } });
+            CHECK(IsSelected(b));
+            CHECK_FALSE(IsSelected(a));
+
+            // Paused until the publish done delay of 20 seconds has passed
+            tick_service->Set(21000);
+            Rank(*handler, { { b, 60 }, { a, 50 } }, false);
+            CHECK_EQ(handler->GetPublishedCount(), 2);
+            CHECK_EQ(handler->GetUnpublishedCount(), 0);
+
+            tick_service->Set(21001);
+            Rank(*handler, { { b, 60 }, { a, 50 } }, false);
+            CHECK_EQ(handler->GetPublishedCount(), 1);
+            CHECK_EQ(handler->GetUnpublishedCount(), 1);
+
+            // Selected again, the unpublished track is reused instead of created
+            tick_service->Set(22000);
+            Rank(*handler, { { a, 70 }, { b, 60 } });
+            CHECK(IsSelected(a));
+            CHECK_FALSE(IsSelected(b));
+            CHECK_EQ(handler->GetPublishedCount(), 2);
+            CHECK_EQ(handler->GetUnpublishedCount(), 0);
+            CHECK_EQ(factory_calls, 0);
+        }
+
+        TEST_CASE("Unpublished track expires from the reuse cache")
+        {
+            auto tick_service = std::make_shared<sim::SimTickService>();
+            const auto a = MakeTrack(1);
+            const auto b = MakeTrack(2);
+            auto handler = MakeHandler(tick_service, 1, { a, b });
+            handler->SetUnpublishedReuse(1000);
+
+            std::vector<quicr::messages::TrackAlias> factory_calls;
+            const auto created = MakeTrack(1);
+            handler->SetPublishTrackFactory([&](quicr::messages::TrackAlias track_alias, uint64_t connection_id) {
+                CHECK_EQ(connection_id, kPublisherConnId);
+                factory_calls.push_back(track_alias);
+                return created;
+            });
+
+            Rank(*handler, { { a, 50 }, { b, 40 } });
+
+            tick_service->Set(1000);
+            Rank(*handler, { { b, 60 }, { a, 50 } });
+
+            tick_service->Set(21001);
+            Rank(*handler, { { b, 60 }, { a, 50 } }, false);
+            CHECK_EQ(handler->GetUnpublishedCount(), 1);
+
+            tick_service->Set(22001);
+            Rank(*handler, { { b, 60 }, { a, 50 } }, false);
+            CHECK_EQ(handler->GetUnpublishedCount(), 1);
+
+            tick_service->Set(22002);
+            Rank(*handler, { { b, 60 }, { a, 50 } }, false);
+            CHECK_EQ(handler->GetUnpublishedCount(), 0);
+
+            // No longer cached, the publish track is created by the factory
+            Rank(*handler, { { a, 70 }, { b, 60 } });
+            REQUIRE_EQ(factory_calls.size(), 1);
+            CHECK_EQ(factory_calls[0], a->GetTrackAlias().value());
+            CHECK(IsSelected(created));
+            CHECK_FALSE(IsSelected(a));
+            CHECK_EQ(handler->GetPublishedCount(), 2);
+        }
+
+        TEST_CASE("Track is not selected when the publish track factory returns nullptr")
+        {
+            auto tick_service = std::make_shared<sim::SimTickService>();
+            const auto a = MakeTrack(1);
+            const auto b = MakeTrack(2);
+            auto handler = MakeHandler(tick_service, 2, { b });
+
+            std::size_t factory_calls{ 0 };
+            handler->SetPublishTrackFactory([&](quicr::messages::TrackAlias, uint64_t) {
+                factory_calls++;
+                return nullptr;
+            });
+
+            // Track a is ranked but was never published to this handler and is no longer published to the relay
+            Rank(*handler, { { a, 70 }, { b, 60 } });
+            CHECK_EQ(factory_calls, 1);
+            CHECK(IsSelected(b));
+            CHECK_EQ(handler->GetPublishedCount(), 1);
+            CHECK_EQ(handler->GetUnpublishedCount(), 0);
+
+            // Not selected, so it's restored again when the candidates change
+            Rank(*handler, { { a, 75 }, { b, 60 } });
+            CHECK_EQ(factory_calls, 2);
+            CHECK(IsSelected(b));
+            CHECK_EQ(handler->GetPublishedCount(), 1);
+        }
+    }
+}
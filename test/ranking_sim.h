@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+#pragma once
+
+#include <quicr/publish_track_handler.h>
+#include <timeq/tick_service.h>
+
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+#include <utility>
+
+/*
+ * Simulation helpers shared by the track ranking tests and benchmark
+ */
+namespace laps::sim {
+    /**
+     * @brief Tick service set by the simulation
+     */
+    class SimTickService : public timeq::tick_service
+    {
+      public:
+        using DurationType = std::remove_cvref_t<decltype(std::declval<const timeq::tick_service&>().get())>;
+
+        DurationType get() const override { return std::chrono::duration_cast<DurationType>(now_.load()); }
+
+        void Set(uint64_t now_ms) { now_ = std::chrono::milliseconds(now_ms); }
+
+      private:
+        std::atomic<std::chrono::milliseconds> now_{ std::chrono::milliseconds(0) };
+    };
+
+    /**
+     * @brief Publish track that is only ranked and never sent
+     * @details Track alias is the full name hash, same as the relay sets for namespace publish tracks.
+     */
+    class SimPublishTrackHandler : public quicr::PublishTrackHandler
+    {
+      public:
+        SimPublishTrackHandler(const quicr::FullTrackName& full_track_name)
+          : quicr::PublishTrackHandler(full_track_name, quicr::TrackMode::kStream, 1, 1000, std::nullopt, { 0, 0 })
+        {
+            SetTrackAlias(quicr::TrackHash(full_track_name).track_fullname_hash);
+        }
+
+        void Pause() { SetStatus(Status::kPaused); }
+    };
+}
@@ -0,0 +1,88 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024 Cisco Systems
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <doctest/doctest.h>
+
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "state_table.h"
+
+namespace laps {
+
+    TEST_SUITE("ConnectionTable")
+    {
+        TEST_CASE("Add and find entries")
+        {
+            ConnectionTable<uint64_t, int> table;
+
+            auto [it, is_new] = table.try_emplace({ 100, 1 }, 10);
+            CHECK(is_new);
+            CHECK_EQ(it->second, 10);
+
+            std::tie(it, is_new) = table.try_emplace({ 100, 1 }, 20);
+            CHECK_FALSE(is_new);
+            CHECK_EQ(it->second, 10);
+
+            table[{ 100, 2 }] = 30;
+            table[{ 200, 1 }] = 40;
+
+            CHECK_EQ(table.size(), 3);
+            CHECK(table.contains({ 100, 2 }));
+            CHECK_FALSE(table.contains({ 200, 2 }));
+            CHECK_EQ(table.at({ 200, 1 }), 40);
+            CHECK(table.find({ 300, 1 }) == table.end());
+        }
+
+        TEST_CASE("Connections by id and ids by connection")
+        {
+            ConnectionTable<uint64_t, int> table;
+            table[{ 100, 3 }] = 1;
+            table[{ 100, 1 }] = 2;
+            table[{ 100, 2 }] = 3;
+            table[{ 200, 1 }] = 4;
+
+            const std::set<quicr::ConnectionHandle> conns_100{ 1, 2, 3 };
+            CHECK_EQ(table.Connections(100), conns_100);
+            CHECK_EQ(*table.Connections(100).begin(), 1);
+            CHECK_EQ(table.Connections(200).size(), 1);
+            CHECK(table.Connections(300).empty());
+
+            CHECK_EQ(table.Ids(1).size(), 2);
+            CHECK(table.Ids(1).contains(200));
+            CHECK_EQ(table.Ids(3).size(), 1);
+            CHECK(table.Ids(4).empty());
+        }
+
+        TEST_CASE("Erase keeps indexes in sync")
+        {
+            ConnectionTable<uint64_t, std::shared_ptr<int>> table;
+            table[{ 100, 1 }] = std::make_shared<int>(1);
+            table[{ 100, 2 }] = std::make_shared<int>(2);
+            table[{ 200, 1 }] = std::make_shared<int>(3);
+
+            CHECK_EQ(table.erase({ 100, 1 }), 1);
+            CHECK_EQ(table.erase({ 100, 1 }), 0);
+
+            CHECK_EQ(table.Connections(100).size(), 1);
+            CHECK_EQ(table.Ids(1).size(), 1);
+
+            table.erase(table.find({ 100, 2 }));
+            CHECK(table.Connections(100).empty());
+            CHECK(table.Ids(2).empty());
+
+            // Copy of the index allows erasing while visiting the entries of a connection
+            const auto& ids = table.Ids(1);
+            const std::vector<uint64_t> conn_ids(ids.begin(), ids.end());
+            for (const auto id : conn_ids) {
+                table.erase({ id, 1 });
+            }
+
+            CHECK(table.empty());
+            CHECK(table.Connections(200).empty());
+            CHECK(table.Ids(1).empty());
+        }
+    }
+
+} // namespace laps
@@ -3,6 +3,7 @@
 
 #include <doctest/doctest.h>
 #include <memory>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -238,6 +239,232 @@ namespace laps {
 
             CHECK_EQ(ranking->GetMaxSelected(), 32);
         }
+
+        TEST_CASE("Selected tracks rank order")
+        {
+            auto ranking = std::make_unique<TrackRanking>();
+
+            ranking->UpdateValue(1, 100, 500, 1000, 1);
+            ranking->UpdateValue(2, 100, 600, 1100, 2);
+            ranking->UpdateValue(3, 100, 600, 1200, 3);
+            ranking->UpdateValue(4, 100, 550, 1300, 4);
+
+            auto selected = ranking->GetSelectedTracks(100);
+            REQUIRE_EQ(selected.size(), 4);
+
+            // Higher value first, then the earlier insert for the same value
+            CHECK_EQ(std::get<0>(selected[0]), 2);
+            CHECK_EQ(std::get<0>(selected[1]), 3);
+            CHECK_EQ(std::get<0>(selected[2]), 4);
+            CHECK_EQ(std::get<0>(selected[3]), 1);
+            CHECK_EQ(std::get<3>(selected[2]), 4);
+            CHECK_EQ(std::get<4>(selected[0]), 600);
+            CHECK_EQ(std::get<4>(selected[3]), 500);
+
+            // Decreased value ranks ahead of tracks already at that value
+            ranking->UpdateValue(2, 100, 500, 1400, 2);
+            selected = ranking->GetSelectedTracks(100);
+            REQUIRE_EQ(selected.size(), 4);
+            CHECK_EQ(std::get<0>(selected[0]), 3);
+            CHECK_EQ(std::get<0>(selected[1]), 4);
+            CHECK_EQ(std::get<0>(selected[2]), 2);
+            CHECK_EQ(std::get<0>(selected[3]), 1);
+            CHECK_EQ(std::get<2>(selected[2]), 1400);
+
+            // Same value only refreshes the tick, rank is unchanged
+            ranking->UpdateValue(1, 100, 500, 1500, 1);
+            selected = ranking->GetSelectedTracks(100);
+            CHECK_EQ(std::get<0>(selected[3]), 1);
+            CHECK_EQ(std::get<2>(selected[3]), 1500);
+        }
+
+        TEST_CASE("Selected tracks limited to max selected")
+        {
+            auto ranking = std::make_unique<TrackRanking>();
+            ranking->SetMaxSelected(5);
+
+            for (uint64_t i = 0; i < 100; ++i) {
+                ranking->UpdateValue(i, 100, i, 1000 + i, 1);
+            }
+
+            const auto selected = ranking->GetSelectedTracks(100);
+            REQUIRE_EQ(selected.size(), 5);
+            for (uint64_t i = 0; i < selected.size(); ++i) {
+                CHECK_EQ(std::get<0>(selected[i]), 99 - i);
+            }
+        }
+
+        TEST_CASE("Selected tracks exclude inactive tracks")
+        {
+            auto ranking = std::make_unique<TrackRanking>();
+            ranking->SetInactiveAge(1000);
+
+            ranking->UpdateValue(1, 100, 900, 1000, 1);
+            ranking->UpdateValue(2, 100, 600, 1100, 2);
+            ranking->UpdateValue(3, 200, 800, 1200, 3);
+
+            // Track 1 is inactive (3000 - 1000 > 1000), track 2 is inactive (3000 - 1100 > 1000)
+            ranking->UpdateValue(4, 100, 550, 3000, 4);
+
+            auto selected = ranking->GetSelectedTracks(100);
+            REQUIRE_EQ(selected.size(), 1);
+            CHECK_EQ(std::get<0>(selected[0]), 4);
+
+            // Track 3 of the other property expired with the update and is no longer selected
+            CHECK(ranking->GetSelectedTracks(200).empty());
+
+            ranking->UpdateValue(5, 200, 100, 3000, 5);
+            selected = ranking->GetSelectedTracks(200);
+            REQUIRE_EQ(selected.size(), 1);
+            CHECK_EQ(std::get<0>(selected[0]), 5);
+        }
+
+        TEST_CASE("Inactive tracks expire without updates")
+        {
+            auto ranking = std::make_unique<TrackRanking>();
+            ranking->SetInactiveAge(1000);
+
+            ranking->UpdateValue(1, 100, 500, 1000, 1);
+            ranking->UpdateValue(2, 100, 600, 1500, 2);
+
+            // Not yet inactive, expiry requires more than the inactive age
+            CHECK_EQ(ranking->Expire(2000), 0);
+            CHECK_EQ(ranking->GetSelectedTracks(100).size(), 2);
+
+            CHECK_EQ(ranking->Expire(2001), 1);
+            auto selected = ranking->GetSelectedTracks(100);
+            REQUIRE_EQ(selected.size(), 1);
+            CHECK_EQ(std::get<0>(selected[0]), 2);
+
+            // Refreshed track is rescheduled
+            ranking->UpdateValue(2, 100, 600, 2400, 2);
+            CHECK_EQ(ranking->Expire(2600), 0);
+            CHECK_EQ(ranking->Expire(3401), 1);
+            CHECK(ranking->GetSelectedTracks(100).empty());
+        }
+
+        TEST_CASE("Inactive tracks expire beyond the expiry wheel horizon")
+        {
+            auto ranking = std::make_unique<TrackRanking>();
+            const uint64_t horizon_ms = TrackRanking::kExpiryWheelSlotMs * TrackRanking::kExpiryWheelSlots;
+            ranking->SetInactiveAge(horizon_ms * 2);
+
+            ranking->UpdateValue(1, 100, 500, 1000, 1);
+
+            // Passes the slot of the track more than once before it is due
+            for (uint64_t tick = 1000; tick <= 1000 + horizon_ms * 2; tick += TrackRanking::kExpiryWheelSlotMs) {
+                CHECK_EQ(ranking->Expire(tick), 0);
+            }
+
+            CHECK_EQ(ranking->Expire(1001 + horizon_ms * 2), 1);
+        }
+
+        TEST_CASE("Selected tracks delta")
+        {
+            using Selected = std::vector<TrackRanking::SelectedTrack>;
+
+            const Selected previous{ { 1, 10, 1000, 1, 500 }, { 2, 11, 1000, 2, 500 }, { 3, 12, 1000, 3, 400 } };
+
+            // Only the latest tick changed
+            const Selected same{ { 1, 10, 2000, 1, 500 }, { 2, 11, 2000, 2, 500 }, { 3, 12, 2000, 3, 400 } };
+            TrackRankingDelta delta;
+            delta.selected = same;
+            TrackRanking::ComputeDelta(previous, delta);
+            CHECK(delta.Empty());
+
+            // Track 4 entered at the top, track 3 left, tracks 1 and 2 moved down
+            const Selected changed{ { 4, 13, 2000, 4, 600 }, { 1, 10, 2000, 1, 500 }, { 2, 11, 2000, 2, 500 } };
+            delta = {};
+            delta.selected = changed;
+            TrackRanking::ComputeDelta(previous, delta);
+            const std::vector<uint64_t> moved{ 1, 2 };
+            CHECK_EQ(delta.entered, std::vector<uint64_t>(1, 4));
+            CHECK_EQ(delta.left, std::vector<uint64_t>(1, 3));
+            CHECK_EQ(delta.rank_changed, moved);
+
+            // All tracks left
+            delta = {};
+            TrackRanking::ComputeDelta(previous, delta);
+            const std::vector<uint64_t> all_left{ 1, 2, 3 };
+            CHECK_EQ(delta.left, all_left);
+            CHECK(delta.entered.empty());
+        }
+
+        TEST_CASE("Ranked views per property")
+        {
+            auto ranking = std::make_unique<TrackRanking>();
+
+            // Same tracks ranked in opposite order by two properties
+            ranking->UpdateValue(1, 100, 500, 1000, 1);
+            ranking->UpdateValue(1, 200, 100, 1000, 1);
+            ranking->UpdateValue(2, 100, 100, 1100, 2);
+            ranking->UpdateValue(2, 200, 500, 1100, 2);
+
+            const auto by_100 = ranking->GetSelectedTracks(100);
+            const auto by_200 = ranking->GetSelectedTracks(200);
+            REQUIRE_EQ(by_100.size(), 2);
+            REQUIRE_EQ(by_200.size(), 2);
+            CHECK_EQ(std::get<0>(by_100[0]), 1);
+            CHECK_EQ(std::get<0>(by_100[1]), 2);
+            CHECK_EQ(std::get<0>(by_200[0]), 2);
+            CHECK_EQ(std::get<0>(by_200[1]), 1);
+
+            CHECK(ranking->GetSelectedTracks(300).empty());
+        }
+
+        TEST_CASE("Queued values are coalesced and applied in batch")
+        {
+            auto ranking = std::make_unique<TrackRanking>();
+
+            CHECK_EQ(ranking->ProcessQueued(), 0);
+
+            ranking->QueueValue(1, 100, 500, 1000, 1);
+            ranking->QueueValue(2, 100, 600, 1010, 2);
+            ranking->QueueValue(1, 100, 700, 1020, 1);
+            ranking->QueueValue(1, 200, 300, 1020, 1);
+
+            // Not applied until processed
+            CHECK(ranking->GetSelectedTracks(100).empty());
+
+            // Track 1 of property 100 coalesced to the latest value
+            CHECK_EQ(ranking->ProcessQueued(), 3);
+            CHECK_EQ(ranking->ProcessQueued(), 0);
+
+            const auto selected = ranking->GetSelectedTracks(100);
+            REQUIRE_EQ(selected.size(), 2);
+            CHECK_EQ(std::get<0>(selected[0]), 1);
+            CHECK_EQ(std::get<2>(selected[0]), 1020);
+            CHECK_EQ(std::get<0>(selected[1]), 2);
+            CHECK_EQ(ranking->GetSelectedTracks(200).size(), 1);
+        }
+
+        TEST_CASE("Queued values from multiple threads")
+        {
+            auto ranking = std::make_unique<TrackRanking>();
+            ranking->SetMaxSelected(100);
+
+            std::vector<std::thread> producers;
+            for (uint64_t t = 0; t < 4; ++t) {
+                producers.emplace_back([&ranking, t] {
+                    for (uint64_t i = 0; i < 1000; ++i) {
+                        ranking->QueueValue(t * 10 + i % 10, 100, i, 1000, t);
+                    }
+                });
+            }
+
+            std::size_t applied = 0;
+            while (applied < 40) {
+                applied += ranking->ProcessQueued();
+            }
+            for (auto& producer : producers) {
+                producer.join();
+            }
+            ranking->ProcessQueued();
+
+            const auto selected = ranking->GetSelectedTracks(100);
+            REQUIRE_EQ(selected.size(), 40);
+            CHECK_EQ(std::get<0>(selected[0]) % 10, 9);
+        }
     }
 
 } // namespace laps